@@ -0,0 +1,156 @@
+#include "AsyncWriter.h"
+#include "Trace.h"
+
+AsyncWriter::AsyncWriter()
+    : fileCount(0), busy(false), stopping(false), failed(false) {
+    worker = std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queued.notify_one();
+    worker.join();
+}
+
+void AsyncWriter::push(Command&& command) {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return commands.size() < MAX_QUEUED; });
+    commands.push_back(std::move(command));
+    lock.unlock();
+    queued.notify_one();
+}
+
+int AsyncWriter::open(const std::string& path) {
+    int file;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        file = fileCount++;
+    }
+    push(Command{ CMD_OPEN, file, path });
+    return file;
+}
+
+void AsyncWriter::write(int file, std::string&& buffer) {
+    if (buffer.empty()) return;
+    push(Command{ CMD_WRITE, file, std::move(buffer) });
+}
+
+void AsyncWriter::close(int file) {
+    push(Command{ CMD_CLOSE, file, "" });
+}
+
+std::string AsyncWriter::takeBuffer() {
+    std::string buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!pool.empty()) {
+            buffer = std::move(pool.back());
+            pool.pop_back();
+        }
+    }
+    buffer.clear();
+    buffer.reserve(BUFFER_SIZE);
+    return buffer;
+}
+
+bool AsyncWriter::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return commands.empty() && !busy; });
+    return !failed;
+}
+
+void AsyncWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        queued.wait(lock, [this] { return stopping || !commands.empty(); });
+        if (commands.empty()) return;
+
+        Command command = std::move(commands.front());
+        commands.pop_front();
+        busy = true;
+        if (command.kind == CMD_OPEN && files.size() <= (size_t)command.file) {
+            files.resize(command.file + 1);
+        }
+        std::ofstream* out = (size_t)command.file < files.size() ? files[command.file].get() : nullptr;
+        lock.unlock();
+
+        //  -  
+        bool ok = true;
+        if (command.kind == CMD_OPEN) {
+            std::unique_ptr<std::ofstream> stream(new std::ofstream(command.data));
+            ok = stream->is_open();
+            lock.lock();
+            files[command.file] = std::move(stream);
+            lock.unlock();
+        }
+        else if (command.kind == CMD_WRITE) {
+            TraceSpan span("AsyncWriter::write", TRACE_PASSES);
+            ok = out && out->write(command.data.data(), (std::streamsize)command.data.size()).good();
+        }
+        else if (out) {
+            out->close();
+            ok = !out->fail();
+        }
+
+        lock.lock();
+        if (!ok) failed = true;
+        if (command.kind == CMD_WRITE && pool.size() < MAX_POOLED) {
+            pool.push_back(std::move(command.data));
+        }
+        busy = false;
+        done.notify_all();
+    }
+}
+
+AsyncOutputStream::Buffer::Buffer(AsyncWriter& asyncWriter, int outputFile)
+    : writer(asyncWriter), file(outputFile) {
+    reset();
+}
+
+void AsyncOutputStream::Buffer::reset() {
+    data = writer.takeBuffer();
+    data.resize(AsyncWriter::BUFFER_SIZE);
+    setp(&data[0], &data[0] + data.size());
+}
+
+void AsyncOutputStream::Buffer::release() {
+    size_t used = pptr() - pbase();
+    if (used == 0) return;
+    data.resize(used);
+    writer.write(file, std::move(data));
+    reset();
+}
+
+AsyncOutputStream::Buffer::int_type AsyncOutputStream::Buffer::overflow(int_type c) {
+    release();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+//flush     :    
+int AsyncOutputStream::Buffer::sync() {
+    release();
+    return 0;
+}
+
+AsyncOutputStream::AsyncOutputStream(AsyncWriter& asyncWriter, const std::string& path)
+    : std::ostream(nullptr), writer(asyncWriter), file(asyncWriter.open(path)), buffer(asyncWriter, file), closed(false) {
+    rdbuf(&buffer);
+}
+
+AsyncOutputStream::~AsyncOutputStream() {
+    close();
+}
+
+void AsyncOutputStream::close() {
+    if (closed) return;
+    closed = true;
+    buffer.release();
+    writer.close(file);
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+//     .     
+//  ;    ,   
+//   .      
+class AsyncWriter {
+public:
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+    AsyncWriter();
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    //   write  close;     
+    int open(const std::string& path);
+    void write(int file, std::string&& buffer);
+    void close(int file);
+
+    //   
+    std::string takeBuffer();
+
+    //   ; false -       
+    bool finish();
+
+private:
+    enum CommandKind { CMD_OPEN, CMD_WRITE, CMD_CLOSE };
+
+    struct Command {
+        CommandKind kind;
+        int file;
+        std::string data;       //  CMD_OPEN,   CMD_WRITE
+    };
+
+    static const size_t MAX_QUEUED = 16;    //    -   
+    static const size_t MAX_POOLED = 8;
+
+    std::mutex mutex;
+    std::condition_variable queued;         //    
+    std::condition_variable done;           // 
+    std::deque<Command> commands;
+    std::vector<std::string> pool;
+    std::vector<std::unique_ptr<std::ofstream>> files;
+    int fileCount;
+    bool busy;
+    bool stopping;
+    bool failed;
+    std::thread worker;
+
+    void push(Command&& command);
+    void run();
+};
+
+//     AsyncWriter:    ,
+//       
+class AsyncOutputStream : public std::ostream {
+public:
+    AsyncOutputStream(AsyncWriter& writer, const std::string& path);
+    ~AsyncOutputStream();
+
+    void close();
+
+private:
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(AsyncWriter& writer, int file);
+        void release();         //  
+
+    protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+
+    private:
+        AsyncWriter& writer;
+        int file;
+        std::string data;
+
+        void reset();
+    };
+
+    AsyncWriter& writer;
+    int file;
+    Buffer buffer;
+    bool closed;
+};
\ No newline at end of file
@@ -0,0 +1,286 @@
+#include "Batch.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+//     :       
+const size_t WAVE_BLOCKS = 16;
+
+// :   ,     
+//   Print   
+struct BatchRunner::Worker {
+    std::vector<VmValue> vars;
+    std::vector<VmValue> temps;
+    std::vector<VmValue*> stack;
+    std::vector<std::string> lines;
+};
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        fields.push_back(trim(line.substr(start, comma == std::string::npos ? std::string::npos : comma - start)));
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return fields;
+}
+
+bool BatchRunner::fail(const std::string& message) {
+    error = message;
+    return false;
+}
+
+int BatchRunner::findSlot(const std::string& name) const {
+    const std::vector<std::string>& names = vm->getSlotNames();
+    for (size_t slot = 0; slot < names.size(); slot++) {
+        if (names[slot] == name) return (int)slot;
+    }
+    return -1;
+}
+
+bool BatchRunner::load(const VirtualMachine& machine) {
+    for (uint32_t length : machine.getSlotLengths()) {
+        if (length > 0) return fail("Arrays are not supported in batch mode");
+    }
+    vm = &machine;
+    columns.assign(machine.getSlotTypes().size(), std::vector<VmValue>());
+    records = 0;
+    return true;
+}
+
+bool BatchRunner::readValues(const std::string& path) {
+    if (!vm) return fail("Program is not loaded");
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return fail("Cannot open values file " + path);
+    columns.assign(columns.size(), std::vector<VmValue>());
+    records = 0;
+
+    char magic[4] = {};
+    in.read(magic, sizeof(magic));
+    in.clear();
+    in.seekg(0);
+    if (std::memcmp(magic, BATCH_MAGIC, sizeof(magic)) == 0) return readBinary(in);
+    return readCsv(in);
+}
+
+bool BatchRunner::readCsv(std::istream& in) {
+    std::string line;
+    if (!std::getline(in, line)) return fail("Values file is empty");
+
+    std::vector<int> slots;
+    for (const auto& name : splitCsv(line)) {
+        int slot = findSlot(name);
+        if (slot < 0) return fail("Unknown variable '" + name + "' in values file");
+        if (std::count(slots.begin(), slots.end(), slot) > 0) {
+            return fail("Variable '" + name + "' is listed twice in values file");
+        }
+        slots.push_back(slot);
+    }
+
+    int lineNumber = 1;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (trim(line).empty()) continue;
+
+        std::vector<std::string> fields = splitCsv(line);
+        if (fields.size() != slots.size()) {
+            return fail("Line " + std::to_string(lineNumber) + ": expected " + std::to_string(slots.size()) + " values");
+        }
+        for (size_t k = 0; k < fields.size(); k++) {
+            const char* text = fields[k].c_str();
+            char* end = nullptr;
+            VmValue value;
+            errno = 0;
+            if (vm->getSlotTypes()[slots[k]] == TT_REAL) value.r = std::strtod(text, &end);
+            else value.i = std::strtoll(text, &end, 10);
+            if (end == text || *end != '\0' || errno == ERANGE) {
+                return fail("Line " + std::to_string(lineNumber) + ": bad value '" + fields[k] + "'");
+            }
+            columns[slots[k]].push_back(value);
+        }
+        records++;
+    }
+    return true;
+}
+
+bool BatchRunner::readBinary(std::istream& in) {
+    BatchHeader header;
+    if (!in.read((char*)&header, sizeof(header)) || header.version != BATCH_VERSION) {
+        return fail("Unsupported values file version");
+    }
+
+    //      :      
+    std::streampos start = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(start);
+    if (start < 0 || end < start) return fail("Values file is corrupted");
+    uint64_t available = (uint64_t)(end - start) / sizeof(VmValue);
+    if (header.columnCount > available || (header.columnCount > 0 && header.recordCount > available / header.columnCount)) {
+        return fail("Values file is truncated");
+    }
+    records = (size_t)header.recordCount;
+
+    for (uint32_t c = 0; c < header.columnCount; c++) {
+        uint32_t nameLength = 0;
+        uint32_t type = 0;
+        if (!in.read((char*)&nameLength, sizeof(nameLength)) || nameLength > 1024) return fail("Values file is corrupted");
+        std::string name(nameLength, '\0');
+        if (!in.read(&name[0], nameLength) || !in.read((char*)&type, sizeof(type))) return fail("Values file is truncated");
+        if (type != BATCH_INTEGER && type != BATCH_REAL) return fail("Values file is corrupted");
+
+        int slot = findSlot(name);
+        if (slot < 0) return fail("Unknown variable '" + name + "' in values file");
+        if (!columns[slot].empty()) return fail("Variable '" + name + "' is listed twice in values file");
+
+        std::vector<VmValue>& column = columns[slot];
+        column.resize(records);
+        if (!in.read((char*)column.data(), (std::streamsize)(records * sizeof(VmValue)))) {
+            return fail("Values file is truncated");
+        }
+
+        //    ,   
+        bool real = vm->getSlotTypes()[slot] == TT_REAL;
+        if (real && type == BATCH_INTEGER) vectorI2R(column.data(), column.data(), records);
+        if (!real && type == BATCH_REAL) vectorR2I(column.data(), column.data(), records);
+    }
+    return true;
+}
+
+//    :   -   
+//      ,   
+//  ,        
+void BatchRunner::runBlock(Worker& worker, size_t first, size_t count, std::string& out) const {
+    const std::vector<TokenType>& printTypes = vm->getPrintTypes();
+    VmValue* vars = worker.vars.data();
+    VmValue** sp = worker.stack.data();
+
+    for (size_t slot = 0; slot < columns.size(); slot++) {
+        if (columns[slot].empty()) vectorFill(vars + slot * BLOCK, VmValue{ 0 }, count);
+        else std::memcpy(vars + slot * BLOCK, columns[slot].data() + first, count * sizeof(VmValue));
+    }
+    for (auto& line : worker.lines) line.clear();
+
+    for (const VmInstr& instr : vm->getCode()) {
+        VmValue* temp = worker.temps.data() + (sp - worker.stack.data()) * BLOCK;
+        switch (instr.op) {
+        case VM_PUSH_I:
+        case VM_PUSH_R:
+            *++sp = temp + BLOCK;
+            vectorFill(*sp, instr.imm, count);
+            break;
+        case VM_LOAD:
+            *++sp = vars + instr.arg * BLOCK;
+            break;
+        case VM_STORE:
+            if (*sp != vars + instr.arg * BLOCK) std::memcpy(vars + instr.arg * BLOCK, *sp, count * sizeof(VmValue));
+            --sp;
+            break;
+        case VM_ADD_I:
+            vectorAddI(temp - BLOCK, sp[-1], sp[0], count);
+            *--sp = temp - BLOCK;
+            break;
+        case VM_ADD_R:
+            vectorAddR(temp - BLOCK, sp[-1], sp[0], count);
+            *--sp = temp - BLOCK;
+            break;
+        case VM_SUB_I:
+            vectorSubI(temp - BLOCK, sp[-1], sp[0], count);
+            *--sp = temp - BLOCK;
+            break;
+        case VM_SUB_R:
+            vectorSubR(temp - BLOCK, sp[-1], sp[0], count);
+            *--sp = temp - BLOCK;
+            break;
+        case VM_I2R:
+            vectorI2R(temp, sp[0], count);
+            sp[0] = temp;
+            break;
+        case VM_I2R_NEXT:
+            vectorI2R(temp - BLOCK, sp[-1], count);
+            sp[-1] = temp - BLOCK;
+            break;
+        case VM_R2I:
+            vectorR2I(temp, sp[0], count);
+            sp[0] = temp;
+            break;
+        case VM_PRINT: {
+            //   ,   VirtualMachine::print
+            sp -= instr.arg;
+            char number[32];
+            for (size_t record = 0; record < count; record++) {
+                std::string& line = worker.lines[record];
+                line += std::to_string(first + record);
+                for (uint32_t k = 0; k < instr.arg; k++) {
+                    const VmValue& value = sp[k + 1][record];
+                    if (printTypes[(size_t)instr.imm.i + k] == TT_REAL) std::snprintf(number, sizeof(number), "%g", value.r);
+                    else std::snprintf(number, sizeof(number), "%lld", value.i);
+                    line += k == 0 ? '\t' : ' ';
+                    line += number;
+                }
+                line += '\n';
+            }
+            break;
+        }
+        case VM_HALT:
+            for (size_t record = 0; record < count; record++) out += worker.lines[record];
+            return;
+        default:
+            //     ,   load  
+            return;
+        }
+    }
+}
+
+void BatchRunner::run(std::ostream& out, unsigned threads) {
+    if (!vm || records == 0) return;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    size_t blocks = (records + BLOCK - 1) / BLOCK;
+    threads = (unsigned)std::min<size_t>(threads, blocks);
+    size_t waveBlocks = threads * WAVE_BLOCKS;
+    std::vector<std::string> outputs(waveBlocks);
+
+    for (size_t wave = 0; wave < blocks; wave += waveBlocks) {
+        size_t waveEnd = std::min(blocks, wave + waveBlocks);
+        std::atomic<size_t> next(wave);
+
+        auto work = [&]() {
+            Worker worker;
+            worker.vars.resize(columns.size() * BLOCK);
+            worker.temps.resize((vm->getMaxStack() + 1) * BLOCK);
+            worker.stack.resize(vm->getMaxStack() + 1);
+            worker.lines.resize(BLOCK);
+            for (size_t block; (block = next++) < waveEnd;) {
+                std::string& text = outputs[block - wave];
+                text.clear();
+                size_t first = block * BLOCK;
+                runBlock(worker, first, std::min(BLOCK, records - first), text);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back(work);
+        work();
+        for (auto& thread : pool) thread.join();
+
+        for (size_t block = wave; block < waveEnd; block++) {
+            out.write(outputs[block - wave].data(), outputs[block - wave].size());
+        }
+    }
+    out.flush();
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include "VirtualMachine.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//    (little-endian): ,   .
+//:   (uint32), ,  (BATCH_INTEGER  BATCH_REAL, uint32)
+// recordCount   8  (int64  double)
+const char BATCH_MAGIC[4] = { 'Y', 'C', 'O', 'L' };
+const uint32_t BATCH_VERSION = 1;
+const uint32_t BATCH_INTEGER = 0;
+const uint32_t BATCH_REAL = 1;
+
+struct BatchHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t columnCount;
+    uint32_t reserved;
+    uint64_t recordCount;
+};
+
+// :       .
+//    ,    
+//   (  -  ,   
+//SIMD),    .  Print   
+//      "<TAB>"
+class BatchRunner {
+public:
+    static constexpr size_t BLOCK = 1024;   //  
+
+    BatchRunner() : vm(nullptr), records(0) {}
+
+    //   ;      
+    bool load(const VirtualMachine& machine);
+
+    // :   BATCH_MAGIC  CSV     
+    //. ,    ,   ,   
+    bool readValues(const std::string& path);
+
+    //threads -  , 0 -   
+    void run(std::ostream& out, unsigned threads = 0);
+
+    const std::string& getError() const { return error; }
+    size_t getRecords() const { return records; }
+
+private:
+    const VirtualMachine* vm;
+    std::vector<std::vector<VmValue>> columns;  //  ,  - 
+    size_t records;
+    std::string error;
+
+    struct Worker;
+
+    bool fail(const std::string& message);
+    int findSlot(const std::string& name) const;
+    bool readCsv(std::istream& in);
+    bool readBinary(std::istream& in);
+    void runBlock(Worker& worker, size_t first, size_t count, std::string& out) const;
+};
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "Benchmark.h"
+#include "Lexer.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "Memory.h"
+#include "Stats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+static const char* const shapeNames[] = { "decls", "chains", "parens", "calls", "errors", "mixed" };
+static const int shapeCount = 6;
+
+//  :    .  
+//   ,      ,
+//    
+static const double LINEAR = 1.5;
+static const double QUADRATIC = 2.5;
+
+//  :      , 
+// .      O( * ) ,
+//      
+struct StressCase {
+    const char* name;
+    int start;
+    double bounds[3];
+};
+
+static const StressCase stressCases[] = {
+    { "collisions", 256, { LINEAR, LINEAR, LINEAR } },
+    { "junk", 1024, { LINEAR, LINEAR, LINEAR } },
+    { "longline", 1024, { LINEAR, LINEAR, LINEAR } },
+    { "nesting", 16, { LINEAR, QUADRATIC, LINEAR } },
+    { "varlist", 1024, { LINEAR, LINEAR, LINEAR } },
+};
+static const int stressCount = 5;
+
+// :      
+static const char* const benchInFile = "bench_input.txt";
+static const char* const benchLexerFile = "bench_output.txt";
+static const char* const benchParserFile = "bench_output2.txt";
+static const char* const benchSemanticFile = "bench_output3.txt";
+
+//    :     
+static std::string varName(int index) {
+    std::string name = "v";
+    do {
+        name.push_back((char)('a' + index % 26));
+        index /= 26;
+    } while (index > 0);
+    return name;
+}
+
+static void declareVariables(std::ostringstream& src, int count) {
+    src << "INTEGER ";
+    for (int v = 0; v < count; v++) src << (v ? ", " : "") << varName(v);
+    src << "\nREAL x, y\n";
+}
+
+//,      :     
+//    
+static std::vector<std::string> collidingNames(int count) {
+    HashTable<VarInfo> probe(211);
+    std::vector<std::string> names;
+    int bucket = -1;
+    for (int index = 0; (int)names.size() < count; index++) {
+        std::string name = varName(index);
+        int cell = probe.hashFunc(probe.hashFunc(name));
+        if (bucket < 0) bucket = cell;
+        if (cell == bucket) names.push_back(name);
+    }
+    return names;
+}
+
+std::string generateStressProgram(StressShape shape, int size) {
+    std::ostringstream src;
+    src << "PROGRAM Stress\n";
+
+    if (shape == STRESS_COLLISIONS) {
+        // ,        -  
+        std::vector<std::string> names = collidingNames(size);
+        for (int n = 0; n < size; n += 8) {
+            src << "INTEGER ";
+            for (int v = n; v < std::min(size, n + 8); v++) src << (v > n ? ", " : "") << names[v];
+            src << "\n";
+        }
+        for (int n = 0; n + 1 < size; n += 2) src << names[n] << " = " << names[n + 1] << " + 1\n";
+    }
+    else if (shape == STRESS_JUNK) {
+        // '='  31 ,     
+        static const char* const junk[] = { "1", "+", "(", "x", ")", ",", "-", "2.5" };
+        src << "INTEGER a\n";
+        for (int n = 0; n < size; n += 32) {
+            src << "a = =";
+            for (int t = 0; t < 31; t++) src << " " << junk[t % 8];
+            src << "\n";
+        }
+    }
+    else if (shape == STRESS_LONG_LINE) {
+        declareVariables(src, 26);
+        src << "va = vb";
+        for (int t = 1; t < size; t++) src << (t % 2 ? " - " : " + ") << varName(t % 26);
+        src << "\n";
+    }
+    else if (shape == STRESS_NESTING) {
+        declareVariables(src, 26);
+        for (int n = 0; n < 4; n++) {
+            src << varName(n) << " = ";
+            for (int d = 0; d < size; d++) src << "(" << varName(d % 26) << (d % 2 ? " - " : " + ");
+            src << "1";
+            for (int d = 0; d < size; d++) src << ")";
+            src << "\n";
+        }
+    }
+    else {
+        src << "INTEGER ";
+        for (int v = 0; v < size; v++) src << (v ? ", " : "") << varName(v);
+        src << "\nva = vb + vc\n";
+    }
+    src << "END Stress\n";
+    return src.str();
+}
+
+BenchProgram generateBenchProgram(BenchShape shape, int statements) {
+    const int vars = 26;
+    std::ostringstream src;
+    BenchProgram program{ "", 0 };
+
+    src << "PROGRAM Bench\n";
+    if (shape != SHAPE_DECLS) {
+        declareVariables(src, vars);
+        program.statements += 2;
+    }
+
+    for (int n = 0; n < statements; n++) {
+        // : ,     
+        int kind = shape == SHAPE_MIXED ? SHAPE_CHAINS + n % 3 : (int)shape;
+        std::string target = varName(n % vars);
+
+        if (kind == SHAPE_DECLS) {
+            //     
+            src << (n % 2 ? "REAL " : "INTEGER ");
+            for (int v = 0; v < 8; v++) src << (v ? ", " : "") << varName(n * 8 + v);
+            src << "\n";
+        }
+        else if (kind == SHAPE_CHAINS) {
+            src << target << " = " << varName((n + 1) % vars);
+            for (int t = 0; t < 63; t++) {
+                src << (t % 2 ? " - " : " + ");
+                if (t % 5 == 4) src << t + 1;
+                else src << varName((n + t * 7) % vars);
+            }
+            src << "\n";
+        }
+        else if (kind == SHAPE_PARENS) {
+            const int depth = 32;
+            src << target << " = ";
+            for (int d = 0; d < depth; d++) src << "(" << varName((n + d) % vars) << (d % 2 ? " - " : " + ");
+            src << n % 100;
+            for (int d = 0; d < depth; d++) src << ")";
+            src << "\n";
+        }
+        else if (kind == SHAPE_CALLS) {
+            src << "CALL Print (" << target << ", " << varName((n + 3) % vars) << ", x, y, " << n % 10 << ", 2.5)\n";
+        }
+        else {
+            //  :  ,  ,
+            // '=',  ,   CALL
+            switch (n % 5) {
+            case 0: src << "undef = " << target << " + 1\n"; break;
+            case 1: src << target << " = " << target << " + \n"; break;
+            case 2: src << target << " = = " << n % 10 << "\n"; break;
+            case 3: src << target << " = 2.5 - 1\n"; break;
+            default: src << "CALL Print (" << target << ", 1\n"; break;
+            }
+        }
+        program.statements++;
+    }
+    src << "END Bench\n";
+    program.statements += 2;
+    program.text = src.str();
+    return program;
+}
+
+static void deleteTree(Node* node) {
+    if (!node) return;
+    for (auto child : node->children) {
+        deleteTree(child);
+    }
+    delete node;
+}
+
+//   , 
+//   (   )
+struct PhaseTimes {
+    double lexer;
+    double parser;
+    double semantic;
+    double total;
+    size_t bytes[3];
+};
+
+//   ,     
+static size_t phaseBytes(int phase) {
+    return MemoryTracker::getPhase(phase).bytes;
+}
+
+static PhaseTimes compileOnce(size_t& tokenCount) {
+    typedef std::chrono::steady_clock Clock;
+    PhaseTimes times;
+    size_t before[3] = { phaseBytes(CompileStats::PHASE_LEXER), phaseBytes(CompileStats::PHASE_PARSER),
+        phaseBytes(CompileStats::PHASE_SEMANTIC) };
+
+    //   ,    compileFile
+    auto start = Clock::now();
+    MemoryTracker::beginPhase(CompileStats::PHASE_LEXER);
+    Lexer lexer(benchInFile, benchLexerFile);
+    lexer.run();
+    std::vector<Token> tokens = lexer.getTokens();
+    std::vector<Token> validTokens;
+    for (const auto& token : tokens) {
+        if (token.getType() != TT_ERROR && token.getType() != TT_UNKNOWN) {
+            validTokens.push_back(token);
+        }
+    }
+    auto lexed = Clock::now();
+
+    MemoryTracker::beginPhase(CompileStats::PHASE_PARSER);
+    std::ofstream parserOutput(benchParserFile);
+    Synt parser(validTokens, parserOutput);
+    parser.synt();
+    auto parsed = Clock::now();
+
+    MemoryTracker::beginPhase(CompileStats::PHASE_SEMANTIC);
+    std::ofstream semanticOutput(benchSemanticFile);
+    SemanticAnalyzer analyzer(parser.getTree(), semanticOutput);
+    analyzer.analyze();
+    auto analyzed = Clock::now();
+    MemoryTracker::endPhase();
+
+    times.lexer = std::chrono::duration<double>(lexed - start).count();
+    times.parser = std::chrono::duration<double>(parsed - lexed).count();
+    times.semantic = std::chrono::duration<double>(analyzed - parsed).count();
+    times.total = std::chrono::duration<double>(analyzed - start).count();
+
+    for (int phase = 0; phase < 3; phase++) times.bytes[phase] = phaseBytes(phase) - before[phase];
+
+    tokenCount = tokens.size();
+    deleteTree(parser.getTree());
+    return times;
+}
+
+static double percentile(const std::vector<double>& sorted, double q) {
+    size_t index = (size_t)(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void reportPhase(std::ostream& report, const char* shape, int size, const char* phase,
+    std::vector<double> seconds, size_t bytes, size_t tokens, size_t statements) {
+    std::sort(seconds.begin(), seconds.end());
+    double median = percentile(seconds, 0.5);
+    double rate = median > 0 ? 1 / median : 0;
+
+    char line[512];
+    std::snprintf(line, sizeof(line),
+        "{\"shape\":\"%s\",\"size\":%d,\"phase\":\"%s\",\"repeats\":%zu,\"bytes\":%zu,\"tokens\":%zu,"
+        "\"statements\":%zu,\"min_ms\":%.3f,\"p50_ms\":%.3f,\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f,"
+        "\"mb_per_s\":%.2f,\"tokens_per_s\":%.0f,\"statements_per_s\":%.0f}",
+        shape, size, phase, seconds.size(), bytes, tokens, statements,
+        seconds.front() * 1000, median * 1000, percentile(seconds, 0.9) * 1000,
+        percentile(seconds, 0.99) * 1000, seconds.back() * 1000,
+        bytes * rate / 1e6, tokens * rate, statements * rate);
+    report << line << "\n";
+}
+
+bool runBenchmarks(const std::string& shape, int statements, int repeats, std::ostream& report) {
+    bool found = false;
+
+    for (int s = 0; s < shapeCount; s++) {
+        if (shape != "all" && shape != shapeNames[s]) continue;
+        found = true;
+
+        BenchProgram program = generateBenchProgram((BenchShape)s, statements);
+        {
+            std::ofstream input(benchInFile, std::ios::binary);
+            input << program.text;
+        }
+
+        //      
+        size_t tokens = 0;
+        compileOnce(tokens);
+
+        std::vector<double> lexer, parser, semantic, total;
+        for (int r = 0; r < repeats; r++) {
+            PhaseTimes times = compileOnce(tokens);
+            lexer.push_back(times.lexer);
+            parser.push_back(times.parser);
+            semantic.push_back(times.semantic);
+            total.push_back(times.total);
+        }
+
+        size_t bytes = program.text.size();
+        reportPhase(report, shapeNames[s], statements, "lexer", lexer, bytes, tokens, program.statements);
+        reportPhase(report, shapeNames[s], statements, "parser", parser, bytes, tokens, program.statements);
+        reportPhase(report, shapeNames[s], statements, "semantic", semantic, bytes, tokens, program.statements);
+        reportPhase(report, shapeNames[s], statements, "total", total, bytes, tokens, program.statements);
+    }
+
+    for (const char* file : { benchInFile, benchLexerFile, benchParserFile, benchSemanticFile }) {
+        std::remove(file);
+    }
+    return found;
+}
+//    :    
+//  ; -1 -    (     )
+static double growthExponent(const std::vector<int>& sizes, const std::vector<double>& values) {
+    size_t first = sizes.size() > 3 ? sizes.size() - 3 : 0;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    size_t count = 0;
+    for (size_t k = first; k < sizes.size(); k++) {
+        if (values[k] <= 0) return -1;
+        double x = std::log2((double)sizes[k]);
+        double y = std::log2(values[k]);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        count++;
+    }
+    if (count < 2) return -1;
+    return (count * sxy - sx * sy) / (count * sxx - sx * sx);
+}
+
+bool runScaling(const std::string& shape, int steps, int repeats, std::ostream& report, bool& withinBounds) {
+    static const char* const phaseNames[] = { "lexer", "parser", "semantic" };
+    bool found = false;
+    withinBounds = true;
+
+    //    operator new,    
+    if (MemoryTracker::isSupported() && !MemoryTracker::isEnabled()) MemoryTracker::enable();
+
+    for (int s = 0; s < stressCount; s++) {
+        const StressCase& stress = stressCases[s];
+        if (shape != "all" && shape != stress.name) continue;
+        found = true;
+
+        std::vector<int> sizes;
+        std::vector<double> seconds[3];
+        std::vector<double> bytes[3];
+        for (int step = 0, size = stress.start; step < steps; step++, size *= 2) {
+            std::string text = generateStressProgram((StressShape)s, size);
+            {
+                std::ofstream input(benchInFile, std::ios::binary);
+                input << text;
+            }
+
+            //       
+            size_t tokens = 0;
+            PhaseTimes best = compileOnce(tokens);
+            for (int r = 0; r < repeats; r++) {
+                PhaseTimes times = compileOnce(tokens);
+                best.lexer = std::min(best.lexer, times.lexer);
+                best.parser = std::min(best.parser, times.parser);
+                best.semantic = std::min(best.semantic, times.semantic);
+            }
+
+            sizes.push_back(size);
+            double phaseSeconds[3] = { best.lexer, best.parser, best.semantic };
+            for (int phase = 0; phase < 3; phase++) {
+                seconds[phase].push_back(phaseSeconds[phase]);
+                bytes[phase].push_back((double)best.bytes[phase]);
+
+                char line[256];
+                std::snprintf(line, sizeof(line),
+                    "{\"shape\":\"%s\",\"size\":%d,\"phase\":\"%s\",\"bytes\":%zu,\"tokens\":%zu,\"min_ms\":%.3f,\"allocated\":%zu}",
+                    stress.name, size, phaseNames[phase], text.size(), tokens, phaseSeconds[phase] * 1000, best.bytes[phase]);
+                report << line << "\n";
+            }
+        }
+
+        for (int phase = 0; phase < 3; phase++) {
+            double time = growthExponent(sizes, seconds[phase]);
+            double memory = growthExponent(sizes, bytes[phase]);
+            bool ok = time <= stress.bounds[phase] && memory <= stress.bounds[phase];
+            if (!ok) withinBounds = false;
+
+            char line[256];
+            std::snprintf(line, sizeof(line),
+                "{\"shape\":\"%s\",\"phase\":\"%s\",\"time_exponent\":%.2f,\"memory_exponent\":%.2f,\"bound\":%.1f,\"ok\":%s}",
+                stress.name, phaseNames[phase], time, memory, stress.bounds[phase], ok ? "true" : "false");
+            report << line << "\n";
+        }
+    }
+
+    for (const char* file : { benchInFile, benchLexerFile, benchParserFile, benchSemanticFile }) {
+        std::remove(file);
+    }
+    return found;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <ostream>
+#include <string>
+
+//  
+enum BenchShape {
+    SHAPE_DECLS,        // 
+    SHAPE_CHAINS,       //  +  -
+    SHAPE_PARENS,       // 
+    SHAPE_CALLS,        // CALL
+    SHAPE_ERRORS,       //    
+    SHAPE_MIXED         // 
+};
+
+struct BenchProgram {
+    std::string text;
+    size_t statements;
+};
+
+//        size
+enum StressShape {
+    STRESS_COLLISIONS,  //size        211 
+    STRESS_JUNK,        //,   -   ,  size 
+    STRESS_LONG_LINE,   // -  size 
+    STRESS_NESTING,     //     size
+    STRESS_VARLIST      //   size 
+};
+
+//  statements   
+BenchProgram generateBenchProgram(BenchShape shape, int statements);
+std::string generateStressProgram(StressShape shape, int size);
+
+// ,      
+// . shape -    "all";  -   JSON  
+//:  (, , )    /, /, /
+bool runBenchmarks(const std::string& shape, int statements, int repeats, std::ostream& report);
+
+// :    ,  steps ,
+//         
+//(2 -  ).  JSON -      ; false - 
+// , withinBounds -         
+bool runScaling(const std::string& shape, int steps, int repeats, std::ostream& report, bool& withinBounds);
\ No newline at end of file
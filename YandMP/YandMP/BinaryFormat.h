@@ -0,0 +1,184 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+#ifdef __unix__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//       (little-endian).
+//: ,  ,  ,  .
+//     ,    -    .
+//           .
+
+const char BIN_MAGIC[4] = { 'Y', 'B', 'I', 'N' };
+const uint32_t BIN_VERSION = 1;
+const uint32_t BIN_NO_NODE = 0xFFFFFFFF;
+
+struct BinHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t tokenCount;
+    uint32_t tokensOffset;
+    uint32_t nodeCount;
+    uint32_t nodesOffset;
+    uint32_t stringsSize;
+    uint32_t stringsOffset;
+    uint32_t rootNode;          //BIN_NO_NODE,   
+    uint32_t reserved;
+};
+
+//:  ( TokenType), ,    
+struct BinToken {
+    uint32_t type;
+    uint32_t line;
+    uint32_t lexeme;
+    uint32_t lexemeLength;
+};
+
+// :       firstChild
+struct BinNode {
+    uint32_t name;
+    uint32_t nameLength;
+    uint32_t value;
+    uint32_t valueLength;
+    int32_t line;
+    uint32_t firstChild;
+    uint32_t childCount;
+};
+
+//        ,
+//       little-endian    
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Binary format requires a little-endian target"
+#endif
+static_assert(sizeof(BinHeader) == 40 && sizeof(BinToken) == 16 && sizeof(BinNode) == 28,
+    "Binary records must have no padding");
+
+//    :     (mmap),
+//    
+class BinaryView {
+private:
+    const char* data;
+    size_t size;
+    std::vector<char> buffer;   //  
+#ifdef __unix__
+    void* mapped;
+#endif
+
+    const BinHeader* header() const { return reinterpret_cast<const BinHeader*>(data); }
+
+    bool sectionFits(uint32_t offset, uint64_t bytes) const {
+        return offset % 4 == 0 && offset + bytes <= size;
+    }
+
+    bool stringFits(uint32_t offset, uint32_t length) const {
+        return (uint64_t)offset + length <= header()->stringsSize;
+    }
+
+public:
+    BinaryView() : data(nullptr), size(0) {
+#ifdef __unix__
+        mapped = nullptr;
+#endif
+    }
+
+    ~BinaryView() { close(); }
+
+    BinaryView(const BinaryView&) = delete;
+    BinaryView& operator=(const BinaryView&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef __unix__
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mapped = p;
+                data = static_cast<const char*>(p);
+                size = st.st_size;
+            }
+        }
+        ::close(fd);
+#endif
+        if (!data) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) return false;
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+        if (!valid()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef __unix__
+        if (mapped) munmap(mapped, size);
+        mapped = nullptr;
+#endif
+        buffer.clear();
+        data = nullptr;
+        size = 0;
+    }
+
+    // , ,      :  
+    //token(), node()       .  
+    //      ,     - 
+    bool valid() const {
+        if (!data || size < sizeof(BinHeader)) return false;
+        const BinHeader* h = header();
+        if (std::memcmp(h->magic, BIN_MAGIC, 4) != 0 || h->version != BIN_VERSION) return false;
+        if (!sectionFits(h->tokensOffset, (uint64_t)h->tokenCount * sizeof(BinToken))) return false;
+        if (!sectionFits(h->nodesOffset, (uint64_t)h->nodeCount * sizeof(BinNode))) return false;
+        if ((uint64_t)h->stringsOffset + h->stringsSize > size) return false;
+        if (h->rootNode != BIN_NO_NODE && h->rootNode >= h->nodeCount) return false;
+
+        for (uint32_t i = 0; i < h->tokenCount; i++) {
+            const BinToken& t = token(i);
+            if (!stringFits(t.lexeme, t.lexemeLength)) return false;
+        }
+        for (uint32_t i = 0; i < h->nodeCount; i++) {
+            const BinNode& n = node(i);
+            if (!stringFits(n.name, n.nameLength) || !stringFits(n.value, n.valueLength)) return false;
+            if (n.childCount == 0) continue;
+            if (n.firstChild <= i || (uint64_t)n.firstChild + n.childCount > h->nodeCount) return false;
+        }
+        return true;
+    }
+
+    uint32_t tokenCount() const { return header()->tokenCount; }
+    uint32_t nodeCount() const { return header()->nodeCount; }
+    uint32_t rootNode() const { return header()->rootNode; }
+
+    const BinToken& token(uint32_t i) const {
+        return reinterpret_cast<const BinToken*>(data + header()->tokensOffset)[i];
+    }
+
+    const BinNode& node(uint32_t i) const {
+        return reinterpret_cast<const BinNode*>(data + header()->nodesOffset)[i];
+    }
+
+    std::string_view string(uint32_t offset, uint32_t length) const {
+        if ((uint64_t)offset + length > header()->stringsSize) return std::string_view();
+        return std::string_view(data + header()->stringsOffset + offset, length);
+    }
+
+    std::string_view lexeme(const BinToken& t) const { return string(t.lexeme, t.lexemeLength); }
+    std::string_view name(const BinNode& n) const { return string(n.name, n.nameLength); }
+    std::string_view value(const BinNode& n) const { return string(n.value, n.valueLength); }
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "BinaryWriter.h"
+#include "Trace.h"
+#include <fstream>
+
+BinaryWriter::BinaryWriter(const std::vector<Token>& tokenList, Node* root)
+    : tokens(tokenList), astRoot(root) {
+}
+
+//      
+uint32_t BinaryWriter::addString(const std::string& s) {
+    auto it = stringIndex.find(s);
+    if (it != stringIndex.end()) return it->second;
+
+    uint32_t offset = (uint32_t)strings.size();
+    strings += s;
+    strings.push_back('\0');
+    stringIndex.emplace(s, offset);
+    return offset;
+}
+
+//  :      
+void BinaryWriter::addNodes(Node* root) {
+    std::vector<Node*> order;
+    order.push_back(root);
+
+    for (size_t i = 0; i < order.size(); i++) {
+        Node* node = order[i];
+
+        BinNode rec;
+        rec.name = addString(node->name);
+        rec.nameLength = (uint32_t)node->name.size();
+        rec.value = addString(node->value);
+        rec.valueLength = (uint32_t)node->value.size();
+        rec.line = node->lineNumber;
+        rec.firstChild = node->children.empty() ? BIN_NO_NODE : (uint32_t)order.size();
+        rec.childCount = (uint32_t)node->children.size();
+        binNodes.push_back(rec);
+
+        for (auto child : node->children) {
+            order.push_back(child);
+        }
+    }
+}
+
+bool BinaryWriter::write(const std::string& path) {
+    TraceSpan span("BinaryWriter::write");
+    strings.clear();
+    stringIndex.clear();
+    binTokens.clear();
+    binNodes.clear();
+
+    for (const auto& token : tokens) {
+        BinToken rec;
+        rec.type = (uint32_t)token.getType();
+        rec.line = (uint32_t)token.getLine();
+        rec.lexeme = addString(token.getLexeme());
+        rec.lexemeLength = (uint32_t)token.getLexeme().size();
+        binTokens.push_back(rec);
+    }
+    if (astRoot) {
+        addNodes(astRoot);
+    }
+
+    BinHeader header;
+    std::memcpy(header.magic, BIN_MAGIC, 4);
+    header.version = BIN_VERSION;
+    header.tokenCount = (uint32_t)binTokens.size();
+    header.tokensOffset = sizeof(BinHeader);
+    header.nodeCount = (uint32_t)binNodes.size();
+    header.nodesOffset = header.tokensOffset + header.tokenCount * sizeof(BinToken);
+    header.stringsSize = (uint32_t)strings.size();
+    header.stringsOffset = header.nodesOffset + header.nodeCount * sizeof(BinNode);
+    header.rootNode = binNodes.empty() ? BIN_NO_NODE : 0;
+    header.reserved = 0;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(binTokens.data()), binTokens.size() * sizeof(BinToken));
+    out.write(reinterpret_cast<const char*>(binNodes.data()), binNodes.size() * sizeof(BinNode));
+    out.write(strings.data(), strings.size());
+    return out.good();
+}
\ No newline at end of file
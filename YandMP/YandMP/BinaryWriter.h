@@ -0,0 +1,26 @@
+#pragma once
+#include "Token.h"
+#include "Synt.h"
+#include "BinaryFormat.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+//         (BinaryFormat.h)
+class BinaryWriter {
+public:
+    BinaryWriter(const std::vector<Token>& tokenList, Node* root);
+    bool write(const std::string& path);
+
+private:
+    const std::vector<Token>& tokens;
+    Node* astRoot;
+
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> stringIndex;
+    std::vector<BinToken> binTokens;
+    std::vector<BinNode> binNodes;
+
+    uint32_t addString(const std::string& s);
+    void addNodes(Node* root);
+};
\ No newline at end of file
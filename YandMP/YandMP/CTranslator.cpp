@@ -0,0 +1,168 @@
+#include "CTranslator.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+//   ,       C   
+std::string CTranslator::varName(const std::string& name) {
+    return "v_" + name;
+}
+
+std::string CTranslator::realLiteral(double value) {
+    if (std::isinf(value)) return value > 0 ? "HUGE_VAL" : "(-HUGE_VAL)";
+    if (std::isnan(value)) return "NAN";
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.17g", value);
+    std::string result = text;
+    if (result.find_first_of(".e") == std::string::npos) result += ".0";
+    return result;
+}
+
+//        :
+//    - C.   
+//      k      k,
+//      
+bool CTranslator::translate(const ObjectCode& object, std::ostream& out) {
+    VirtualMachine vm;
+    if (!vm.load(object)) {
+        error = vm.getError();
+        return false;
+    }
+    error.clear();
+
+    const auto& slotTypes = vm.getSlotTypes();
+    const auto& slotNames = vm.getSlotNames();
+    const auto& printTypes = vm.getPrintTypes();
+    const auto& slotLengths = vm.getSlotLengths();
+    const auto& printLengths = vm.getPrintLengths();
+
+    std::string programName;
+    for (const auto& symbol : object.getSymbols()) {
+        if (symbol.kind == SYM_PROGRAM) {
+            programName = symbol.name;
+            break;
+        }
+    }
+
+    out << "/* Program " << programName << ", generated by YandMP */\n";
+    out << "#include <math.h>\n";
+    out << "#include <stdio.h>\n\n";
+    out << "/* INTEGER arithmetic wraps modulo 2^64 */\n";
+    out << "static inline long long y_add(long long a, long long b) { return (long long)((unsigned long long)a + (unsigned long long)b); }\n";
+    out << "static inline long long y_sub(long long a, long long b) { return (long long)((unsigned long long)a - (unsigned long long)b); }\n\n";
+    out << "int main(void) {\n";
+
+    // - ,     ;    
+    for (size_t slot = 0; slot < slotTypes.size(); slot++) {
+        out << "    " << (slotLengths[slot] > 0 ? "static " : "") << (slotTypes[slot] == TT_REAL ? "double " : "long long ")
+            << varName(slotNames[slot]);
+        if (slotLengths[slot] > 0) out << "[" << slotLengths[slot] << "];\n";
+        else out << " = 0;\n";
+    }
+    if (!slotTypes.empty()) out << "\n";
+
+    std::vector<std::string> stack;
+    for (const auto& instr : vm.getCode()) {
+        switch (instr.op) {
+        case VM_PUSH_I:
+            stack.push_back(std::to_string(instr.imm.i) + "LL");
+            if (instr.imm.i == INT64_MIN) stack.back() = "(-9223372036854775807LL - 1)";
+            break;
+        case VM_PUSH_R:
+            stack.push_back(realLiteral(instr.imm.r));
+            break;
+        case VM_LOAD:
+            stack.push_back(varName(slotNames[instr.arg]) + (slotLengths[instr.arg] > 0 ? "[k]" : ""));
+            break;
+        case VM_STORE:
+            out << "    " << varName(slotNames[instr.arg]) << " = " << stack.back() << ";\n";
+            stack.pop_back();
+            break;
+        case VM_VSTORE:
+            out << "    for (long long k = 0; k < " << instr.imm.i << "; k++) " << varName(slotNames[instr.arg])
+                << "[k] = " << stack.back() << ";\n";
+            stack.pop_back();
+            break;
+        case VM_SPLAT:
+        case VM_SPLAT_NEXT:
+            break;
+        case VM_ADD_I:
+        case VM_SUB_I:
+        case VM_VADD_I:
+        case VM_VSUB_I: {
+            std::string right = stack.back();
+            stack.pop_back();
+            bool add = instr.op == VM_ADD_I || instr.op == VM_VADD_I;
+            stack.back() = (add ? "y_add(" : "y_sub(") + stack.back() + ", " + right + ")";
+            break;
+        }
+        case VM_ADD_R:
+        case VM_SUB_R:
+        case VM_VADD_R:
+        case VM_VSUB_R: {
+            std::string right = stack.back();
+            stack.pop_back();
+            bool add = instr.op == VM_ADD_R || instr.op == VM_VADD_R;
+            stack.back() = "(" + stack.back() + (add ? " + " : " - ") + right + ")";
+            break;
+        }
+        case VM_I2R:
+        case VM_VI2R:
+            stack.back() = "(double)" + stack.back();
+            break;
+        case VM_I2R_NEXT:
+        case VM_VI2R_NEXT:
+            stack[stack.size() - 2] = "(double)" + stack[stack.size() - 2];
+            break;
+        case VM_R2I:
+        case VM_VR2I:
+            stack.back() = "(long long)" + stack.back();
+            break;
+        case VM_PRINT: {
+            size_t first = stack.size() - instr.arg;
+            bool hasArrays = false;
+            for (uint32_t k = 0; k < instr.arg; k++) {
+                if (printLengths[instr.imm.i + k] > 0) hasArrays = true;
+            }
+
+            if (!hasArrays) {
+                std::string format, args;
+                for (uint32_t k = 0; k < instr.arg; k++) {
+                    if (k > 0) format += " ";
+                    format += printTypes[instr.imm.i + k] == TT_REAL ? "%g" : "%lld";
+                    args += ", " + stack[first + k];
+                }
+                out << "    printf(\"" << format << "\\n\"" << args << ");\n";
+            }
+            else {
+                //   ;    ,  
+                for (uint32_t k = 0; k < instr.arg; k++) {
+                    std::string format = printTypes[instr.imm.i + k] == TT_REAL ? "%g" : "%lld";
+                    uint32_t length = printLengths[instr.imm.i + k];
+                    if (length == 0) {
+                        out << "    printf(\"" << (k > 0 ? " " : "") << format << "\", " << stack[first + k] << ");\n";
+                    }
+                    else {
+                        out << "    for (long long k = 0; k < " << length << "; k++) printf("
+                            << (k > 0 ? "\" " + format + "\"" : "k > 0 ? \" " + format + "\" : \"" + format + "\"")
+                            << ", " << stack[first + k] << ");\n";
+                    }
+                }
+                out << "    printf(\"\\n\");\n";
+            }
+            stack.resize(first);
+            break;
+        }
+        case VM_HALT:
+            break;
+        default:
+            error = "Unsupported instruction";
+            return false;
+        }
+    }
+
+    out << "    return 0;\n";
+    out << "}\n";
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include "ObjectCode.h"
+#include "VirtualMachine.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+//      C.
+//    main (long long  double),
+// -  C, CALL Print -  printf.
+//          
+class CTranslator {
+public:
+    bool translate(const ObjectCode& object, std::ostream& out);
+    const std::string& getError() const { return error; }
+
+private:
+    std::string error;
+
+    static std::string varName(const std::string& name);
+    static std::string realLiteral(double value);
+};
\ No newline at end of file
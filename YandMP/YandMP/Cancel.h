@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+//     ;   
+class CompilationCancelled : public std::exception {
+public:
+    explicit CompilationCancelled(bool deadline) : expired(deadline) {}
+    const char* what() const noexcept override { return expired ? "compilation deadline expired" : "compilation cancelled"; }
+    bool isDeadline() const { return expired; }
+
+private:
+    bool expired;
+};
+
+// : ,     ,  .
+//        
+class CancelToken {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    CancelToken() : cancelled(false), hasDeadline(false) {}
+
+    CancelToken(const CancelToken&) = delete;
+    CancelToken& operator=(const CancelToken&) = delete;
+
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    void setDeadline(Clock::time_point time) { deadline = time; hasDeadline = true; }
+    void setTimeout(long long milliseconds) { setDeadline(Clock::now() + std::chrono::milliseconds(milliseconds)); }
+
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+    bool isExpired() const { return hasDeadline && Clock::now() >= deadline; }
+
+private:
+    std::atomic<bool> cancelled;
+    bool hasDeadline;
+    Clock::time_point deadline;
+};
+
+//     :     ,  - 
+// CLOCK_INTERVAL .      
+class CancelPoll {
+public:
+    CancelPoll() : token(nullptr), polls(0), stopped(false) {}
+
+    void setToken(const CancelToken* cancelToken) { token = cancelToken; }
+
+    //true -   
+    bool poll() {
+        if (!token || stopped) return stopped;
+        stopped = token->isCancelled() || ((++polls & (CLOCK_INTERVAL - 1)) == 0 && token->isExpired());
+        return stopped;
+    }
+
+    //    -   
+    bool check() {
+        if (!token || stopped) return stopped;
+        stopped = token->isCancelled() || token->isExpired();
+        return stopped;
+    }
+
+    bool isStopped() const { return stopped; }
+
+private:
+    static const unsigned CLOCK_INTERVAL = 64;
+
+    const CancelToken* token;
+    unsigned polls;
+    bool stopped;
+};
\ No newline at end of file
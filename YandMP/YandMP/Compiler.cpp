@@ -0,0 +1,383 @@
+#include "Compiler.h"
+#include "Lexer.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "BinaryWriter.h"
+#include "ObjectCode.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "AsyncWriter.h"
+#include "Linker.h"
+#include "Cancel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+//  :   PROGRAM   PROGRAM
+//(   PROGRAM -   )   
+struct CompileUnit {
+    std::vector<Token> tokens;      // ,   
+    std::string name;               //  PROGRAM,  - 
+    int line = -1;                  // PROGRAM, -1 - 
+    ConstantPool constants;         //     
+    ConstantPool* pool = nullptr;
+    std::ostringstream parserText;  // ,   
+    std::ostringstream semanticText;
+    std::ostream* parserOut = nullptr;
+    std::ostream* semanticOut = nullptr;
+    std::unique_ptr<Synt> parser;
+    std::unique_ptr<SemanticAnalyzer> analyzer;
+    ErrorBudget parserBudget;       //     
+    ErrorBudget semanticBudget;
+
+    explicit CompileUnit(const ConstantPool* shared) : constants(shared) {}
+};
+
+static void deleteTree(Node* node) {
+    if (!node) return;
+    for (Node* child : node->children) {
+        deleteTree(child);
+    }
+    delete node;
+}
+
+// :      ,
+//     
+static void cancelCompilation(const CancelToken& cancel, std::vector<std::unique_ptr<CompileUnit>>& units) {
+    for (auto& unit : units) {
+        if (unit->parser) deleteTree(unit->parser->getTree());
+    }
+    throw CompilationCancelled(!cancel.isCancelled());
+}
+
+//    maxErrors; 0    -  
+static ErrorBudget remainingBudget(size_t maxErrors, size_t remaining) {
+    if (maxErrors == 0) return ErrorBudget();
+    return remaining > 0 ? ErrorBudget(remaining) : ErrorBudget::spent();
+}
+
+static void parseUnit(CompileUnit& unit, const std::vector<Token>& tokens, const CancelToken* cancel) {
+    unit.parser = std::make_unique<Synt>(tokens, *unit.parserOut);
+    unit.parser->setErrorBudget(&unit.parserBudget);
+    unit.parser->setCancel(cancel);
+    unit.parser->synt();
+}
+
+static void analyzeUnit(CompileUnit& unit, const CompileFiles& files) {
+    const Synt& parser = *unit.parser;
+    unit.analyzer = std::make_unique<SemanticAnalyzer>(parser.getTree(), *unit.semanticOut);
+    SemanticAnalyzer& semanticAnalyzer = *unit.analyzer;
+    semanticAnalyzer.setOptimize(files.optimize);
+    semanticAnalyzer.setFastMath(files.fastMath);
+    semanticAnalyzer.setConstants(unit.pool);
+    semanticAnalyzer.setCancel(files.cancel);
+    semanticAnalyzer.setErrorBudget(&unit.semanticBudget);
+    if (parser.isStopped() && !parser.getErrors().empty()) {
+        //   ,      
+        *unit.semanticOut << "Semantic analysis skipped: parsing stopped after " << parser.getErrors().size() << " error(s)";
+    }
+    else if (unit.semanticBudget.isSpent()) {
+        //     
+        *unit.semanticOut << "Semantic analysis skipped: error limit reached";
+    }
+    else {
+        semanticAnalyzer.analyze();
+    }
+}
+
+//work(i)     threads  (0 -   );
+// ,    ,  
+template <typename Work>
+static void forEachUnit(size_t count, unsigned threads, Work work) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (unsigned)std::max<size_t>(1, std::min<size_t>(threads, count));
+    std::atomic<size_t> next(0);
+    std::vector<std::exception_ptr> failures(threads);
+
+    auto worker = [&](unsigned t) {
+        try {
+            for (size_t i; (i = next++) < count;) work(i);
+        }
+        catch (...) {
+            failures[t] = std::current_exception();
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : pool) thread.join();
+    for (auto& failure : failures) {
+        if (failure) std::rethrow_exception(failure);
+    }
+}
+
+void compileFile(const CompileFiles& files) {
+    TraceSpan span("compileFile");
+    CompileStats* stats = files.stats;
+
+    //      ,   
+    AsyncWriter writer;
+    AsyncOutputStream lexerOutput(writer, files.lexerOutFile);
+    AsyncOutputStream parserOutput(writer, files.parserOutFile);
+    AsyncOutputStream semanticOutput(writer, files.semanticOutFile);
+
+    // 
+    if (stats) stats->begin(CompileStats::PHASE_LEXER);
+    std::vector<Token> tokens;
+    ConstantPool constants;     // ,  
+    {
+        Lexer lexer(files.inFile, lexerOutput);
+        lexer.setCancel(files.cancel);
+        lexer.run();
+        if (lexer.isCancelled()) throw CompilationCancelled(!files.cancel->isCancelled());
+
+        //       
+        tokens = lexer.getTokens();
+        constants = lexer.getConstants();
+    }
+
+    //  
+    std::vector<Token> validTokens;
+    for (const auto& token : tokens) {
+        if (token.getType() != TT_ERROR and token.getType() != TT_UNKNOWN) {
+            validTokens.push_back(token);
+        }
+    }
+    if (stats) stats->end(CompileStats::PHASE_LEXER);
+
+    // :     PROGRAM,  
+    std::vector<std::unique_ptr<CompileUnit>> units;
+    std::vector<size_t> firstToken;
+    for (size_t i = 0; i < validTokens.size(); i++) {
+        const Token& token = validTokens[i];
+        bool program = token.getType() == TT_KEYWORD && token.getLexeme() == "PROGRAM";
+        if (units.empty() || (program && units.back()->line >= 0)) {
+            units.push_back(std::make_unique<CompileUnit>(&constants));
+            firstToken.push_back(i);
+        }
+        CompileUnit& unit = *units.back();
+        if (program && unit.line < 0) unit.line = token.getLine();
+        else if (unit.line >= 0 && unit.name.empty() && validTokens[i - 1].getLexeme() == "PROGRAM" &&
+            token.getType() == TT_IDENTIFIER) {
+            unit.name = token.getLexeme();
+        }
+    }
+    if (units.empty()) units.push_back(std::make_unique<CompileUnit>(&constants));
+
+    //              
+    bool single = units.size() == 1;
+    for (size_t u = 0; u < units.size(); u++) {
+        auto& unit = units[u];
+        if (!single) {
+            size_t end = u + 1 < units.size() ? firstToken[u + 1] : validTokens.size();
+            unit->tokens.assign(validTokens.begin() + firstToken[u], validTokens.begin() + end);
+        }
+        unit->parserOut = single ? (std::ostream*)&parserOutput : &unit->parserText;
+        unit->semanticOut = single ? (std::ostream*)&semanticOutput : &unit->semanticText;
+        unit->pool = single ? &constants : &unit->constants;
+    }
+
+    //         :  
+    //,  ,   .   ,  
+    //      ; ,   
+    //,    ,      
+    size_t remaining = files.maxErrors;
+
+    // 
+    if (stats) stats->begin(CompileStats::PHASE_PARSER);
+    forEachUnit(units.size(), files.threads, [&](size_t u) {
+        CompileUnit& unit = *units[u];
+        unit.parserBudget = ErrorBudget(files.maxErrors);
+        parseUnit(unit, single ? validTokens : unit.tokens, files.cancel);
+    });
+    if (files.maxErrors > 0) {
+        for (auto& unit : units) {
+            if (unit->parser->isCancelled()) break;
+            size_t count = unit->parser->getErrors().size();
+            if (count < remaining) {
+                remaining -= count;
+                continue;
+            }
+            //     ;    remaining == maxErrors
+            if (remaining < files.maxErrors) {
+                deleteTree(unit->parser->getTree());
+                unit->parserText.str("");
+                unit->parserBudget = remainingBudget(files.maxErrors, remaining);
+                parseUnit(*unit, unit->tokens, files.cancel);
+            }
+            remaining -= unit->parser->getErrors().size();
+        }
+    }
+    for (auto& unit : units) {
+        if (unit->parser->isCancelled()) cancelCompilation(*files.cancel, units);
+    }
+    if (!single) {
+        for (auto& unit : units) parserOutput << unit->parserText.str();
+    }
+    if (stats) stats->end(CompileStats::PHASE_PARSER);
+
+    // ;   -   
+    Node* astRoot = units[0]->parser->getTree();
+    if (!single) {
+        astRoot = new Node("Units");
+        for (auto& unit : units) {
+            if (unit->parser->getTree()) astRoot->addChild(unit->parser->getTree());
+        }
+    }
+
+    if (!files.binaryOutFile.empty()) {
+        if (stats) stats->begin(CompileStats::PHASE_OUTPUT);
+        BinaryWriter writer(tokens, astRoot);
+        if (!writer.write(files.binaryOutFile)) {
+            std::cerr << "Cannot write binary output file\n";
+        }
+        if (stats) stats->end(CompileStats::PHASE_OUTPUT);
+    }
+
+    // 
+    if (stats) stats->begin(CompileStats::PHASE_SEMANTIC);
+    size_t semanticLimit = remaining;
+    forEachUnit(units.size(), files.threads, [&](size_t u) {
+        CompileUnit& unit = *units[u];
+        unit.semanticBudget = remainingBudget(files.maxErrors, semanticLimit);
+        analyzeUnit(unit, files);
+    });
+    if (files.maxErrors > 0) {
+        for (auto& unit : units) {
+            if (unit->analyzer->isCancelled()) break;
+            size_t count = unit->analyzer->getErrorCount();
+            if (count < remaining) {
+                remaining -= count;
+                continue;
+            }
+            if (remaining < semanticLimit) {
+                unit->semanticText.str("");
+                unit->semanticBudget = remainingBudget(files.maxErrors, remaining);
+                analyzeUnit(*unit, files);
+            }
+            remaining -= unit->analyzer->getErrorCount();
+        }
+    }
+    for (auto& unit : units) {
+        if (!unit->analyzer->isCancelled()) continue;
+        if (!single) {
+            //     
+            astRoot->children.clear();
+            delete astRoot;
+        }
+        cancelCompilation(*files.cancel, units);
+    }
+
+    //:  CALL       
+    Linker linker;
+    ErrorBudget linkBudget = remainingBudget(files.maxErrors, remaining);
+    linker.setErrorBudget(&linkBudget);
+    for (size_t u = 0; u < units.size(); u++) {
+        CompileUnit& unit = *units[u];
+        const SemanticAnalyzer& semanticAnalyzer = *unit.analyzer;
+        linker.addUnit(unit.name, unit.line, semanticAnalyzer.getPostfixCode(), semanticAnalyzer.getPostfixLines());
+        if (!single) {
+            if (u > 0) semanticOutput << "\n\n";
+            semanticOutput << unit.semanticText.str();
+            constants.merge(unit.constants);
+        }
+    }
+    bool linked = linker.link();
+    if (!single || !linked) {
+        if (!linked && linker.getErrors().empty()) {
+            //     
+            semanticOutput << "\n\nLinking stopped: error limit reached";
+        }
+        else if (!linked) {
+            semanticOutput << "\n\nLINK ERRORS:\n";
+            for (const auto& error : linker.getErrors()) {
+                semanticOutput << error << "\n";
+            }
+            semanticOutput << "\nLinking " << (linker.isStopped() ? "stopped after " : "completed with ")
+                << linker.getErrors().size() << " error(s)";
+        }
+        else {
+            semanticOutput << "\n\nLinking completed successfully: " << units.size() << " program units, "
+                << linker.getResolvedCalls() << " calls resolved";
+        }
+    }
+    if (stats) stats->end(CompileStats::PHASE_SEMANTIC);
+
+    if (stats) stats->begin(CompileStats::PHASE_OUTPUT);
+    TraceSpan output("output");
+    if (!files.objectOutFile.empty()) {
+        ObjectCode object;
+        if (single) {
+            object.build(units[0]->analyzer->getPostfixCode(), units[0]->analyzer->getPostfixLines(), &constants);
+        }
+        else {
+            //   -   
+            std::vector<std::string> postfixCode;
+            std::vector<int> postfixLines;
+            for (auto& unit : units) {
+                const SemanticAnalyzer& semanticAnalyzer = *unit->analyzer;
+                postfixCode.insert(postfixCode.end(), semanticAnalyzer.getPostfixCode().begin(), semanticAnalyzer.getPostfixCode().end());
+                postfixLines.insert(postfixLines.end(), semanticAnalyzer.getPostfixLines().begin(), semanticAnalyzer.getPostfixLines().end());
+            }
+            object.build(postfixCode, postfixLines, &constants);
+        }
+        if (!object.write(files.objectOutFile)) {
+            std::cerr << "Cannot write object file\n";
+        }
+    }
+    lexerOutput.close();
+    parserOutput.close();
+    semanticOutput.close();
+    if (!writer.finish()) {
+        std::cerr << "Cannot write output files\n";
+    }
+    if (stats) stats->end(CompileStats::PHASE_OUTPUT);
+
+    if (stats) {
+        size_t lexicalErrors = tokens.size() - validTokens.size();
+        stats->countTokens(tokens);
+        size_t symbolLookups = 0, syntaxErrors = 0, warnings = 0;
+        size_t semanticErrors = linker.getErrors().size();
+        for (auto& unit : units) {
+            stats->countNodes(unit->parser->getTree());
+            symbolLookups += unit->analyzer->getSymbolLookups();
+            syntaxErrors += unit->parser->getErrors().size();
+            semanticErrors += unit->analyzer->getErrorCount();
+            warnings += unit->analyzer->getWarnings().size();
+        }
+        stats->setSymbolLookups(symbolLookups);
+        stats->setDiagnostics(lexicalErrors, syntaxErrors, semanticErrors, warnings);
+        if (files.optimize) {
+            size_t sharedNodes = 0, dagNodes = 0, temporaries = 0;
+            for (auto& unit : units) {
+                const ExpressionDag& dag = unit->analyzer->getExpressionDag();
+                sharedNodes += dag.getSharedNodes();
+                dagNodes += dag.getNodeCount();
+                temporaries += dag.getTemporaries();
+            }
+            stats->setCommonSubexpressions(sharedNodes, dagNodes, temporaries);
+
+            size_t chains = 0;
+            int depthBefore = 0, depthAfter = 0;
+            for (auto& unit : units) {
+                const Reassociator& reassociator = unit->analyzer->getReassociator();
+                chains += reassociator.getChains();
+                depthBefore = std::max(depthBefore, reassociator.getDepthBefore());
+                depthAfter = std::max(depthAfter, reassociator.getDepthAfter());
+            }
+            stats->setReassociation(chains, depthBefore, depthAfter);
+        }
+        for (const std::string* path : { &files.lexerOutFile, &files.parserOutFile, &files.semanticOutFile,
+            &files.binaryOutFile, &files.objectOutFile }) {
+            if (!path->empty()) stats->addOutputFile(*path);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+class CompileStats;
+class CancelToken;
+
+//     
+struct CompileFiles {
+    std::string inFile;
+    std::string lexerOutFile;
+    std::string parserOutFile;
+    std::string semanticOutFile;
+    std::string binaryOutFile;      //    (BinaryFormat.h),  -  
+    std::string objectOutFile;      //   (ObjectCode.h),  -  
+    bool optimize = false;          // ,  ,   
+    bool fastMath = false;          // optimize     ( )
+    size_t maxErrors = 0;           //    : ,       , 0 -  
+    unsigned threads = 0;           //     PROGRAM ... END , 0 -   
+    CompileStats* stats = nullptr;  //    (Stats.h), nullptr -  
+    const CancelToken* cancel = nullptr;    //    (Cancel.h), nullptr -  
+};
+
+//  : ,    .
+// PROGRAM ... END       ,
+//  (Linker.h)   CALL   .
+//         ,
+//    CompilationCancelled
+void compileFile(const CompileFiles& files);
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "ConstantFolder.h"
+#include "ObjectCode.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+static std::vector<std::string> splitLine(const std::string& line) {
+    std::vector<std::string> items;
+    std::istringstream stream(line);
+    std::string item;
+    while (stream >> item) items.push_back(item);
+    return items;
+}
+
+static bool isNumber(const std::string& item) {
+    size_t start = item[0] == '-' && item.size() > 1 ? 1 : 0;
+    return std::isdigit((unsigned char)item[start]) != 0;
+}
+
+//    2^64,    
+static long long wrap(long long a, long long b, bool add) {
+    unsigned long long r = add ? (unsigned long long)a + (unsigned long long)b
+        : (unsigned long long)a - (unsigned long long)b;
+    return (long long)r;
+}
+
+//  REAL,    
+std::string ConstantFolder::constantText(TokenType type, long long intValue, double realValue) {
+    if (type != TT_REAL) return std::to_string(intValue);
+
+    char text[32];
+    for (int precision = 1; precision <= 17; precision++) {
+        std::snprintf(text, sizeof(text), "%.*g", precision, realValue);
+        if (std::strtod(text, nullptr) == realValue) break;
+    }
+    std::string result = text;
+    if (result.find_first_of(".e") == std::string::npos) result += ".0";
+    return result;
+}
+
+std::string ConstantFolder::operandText(const Operand& operand) const {
+    if (!operand.constant) return operand.text;
+
+    std::string text = constantText(operand.type, operand.intValue, operand.realValue);
+    if (constants) constants->add(text, operand.type, operand.intValue, operand.realValue);
+    return text;
+}
+
+//  :    ,   -   
+ConstantFolder::Operand ConstantFolder::constantOperand(const std::string& item) const {
+    Operand operand{ true, TT_INTEGER, 0, 0, item };
+    const ConstantPool::Value* value = constants ? constants->find(item) : nullptr;
+    if (value) {
+        operand.type = value->type;
+        operand.intValue = value->intValue;
+        operand.realValue = value->realValue;
+    }
+    else if (item.find_first_of(".eE") != std::string::npos) {
+        operand.type = TT_REAL;
+        operand.realValue = std::strtod(item.c_str(), nullptr);
+    }
+    else {
+        operand.intValue = std::strtoll(item.c_str(), nullptr, 10);
+    }
+    return operand;
+}
+
+bool ConstantFolder::foldExpression(const std::vector<std::string>& items, size_t from, size_t to,
+    std::vector<Operand>& stack) const {
+    for (size_t i = from; i < to; i++) {
+        const std::string& item = items[i];
+
+        int arity = postfixArity(item);
+
+        if (arity == 1) {
+            //I2R:    
+            if (stack.empty()) return false;
+            Operand& operand = stack.back();
+            if (operand.constant && operand.type == TT_INTEGER) {
+                operand.realValue = (double)operand.intValue;
+            }
+            else if (operand.type != TT_REAL) {
+                operand.text = operandText(operand) + " " + item;
+                operand.constant = false;
+            }
+            operand.type = TT_REAL;
+        }
+        else if (arity == 2) {
+            if (stack.size() < 2) return false;
+            bool add = item == "+" || item == "ADD_I" || item == "ADD_R";
+            Operand right = stack.back();
+            stack.pop_back();
+            Operand& left = stack.back();
+
+            bool real = left.type == TT_REAL || right.type == TT_REAL;
+            bool known = left.type != TT_UNKNOWN && right.type != TT_UNKNOWN;
+            TokenType type = known ? (real ? TT_REAL : TT_INTEGER) : TT_UNKNOWN;
+
+            if (left.constant && right.constant) {
+                double result = 0;
+                if (real) {
+                    double l = left.type == TT_REAL ? left.realValue : (double)left.intValue;
+                    double r = right.type == TT_REAL ? right.realValue : (double)right.intValue;
+                    result = add ? l + r : l - r;
+                }
+                //  NaN     -    
+                if (!real || std::isfinite(result)) {
+                    if (real) left.realValue = result;
+                    else left.intValue = wrap(left.intValue, right.intValue, add);
+                    left.type = type;
+                    continue;
+                }
+            }
+            left.text = operandText(left) + " " + operandText(right) + " " + item;
+            left.constant = false;
+            left.type = type;
+        }
+        else if (isNumber(item)) {
+            stack.push_back(constantOperand(item));
+        }
+        else {
+            auto value = values.find(item);
+            if (value != values.end()) {
+                stack.push_back(value->second);
+                continue;
+            }
+            auto type = types.find(item);
+            stack.push_back(Operand{ false, type != types.end() ? type->second : TT_UNKNOWN, 0, 0, item });
+        }
+    }
+    return true;
+}
+
+std::string ConstantFolder::fold(const std::string& line) {
+    std::vector<std::string> items = splitLine(line);
+    if (items.size() < 2) return line;
+
+    const std::string& last = items.back();
+    size_t count = items.size();
+    std::vector<Operand> stack;
+
+    if (last == "PROGRAM" || last == "END") {
+        return line;
+    }
+    if (last == "DECL") {
+        //  ... N DECL
+        TokenType type = items[0] == "INTEGER" ? TT_INTEGER : TT_REAL;
+        for (size_t i = 1; i + 2 < count; i++) {
+            types[items[i]] = type;
+            values.erase(items[i]);
+        }
+        return line;
+    }
+    if (last == "CALL") {
+        // ... N CALL:    
+        if (count < 3 || !foldExpression(items, 1, count - 2, stack)) return line;
+        if (stack.size() + 1 != std::strtoul(items[count - 2].c_str(), nullptr, 10)) return line;
+
+        std::string result = items[0] + " ";
+        for (const auto& operand : stack) result += operandText(operand) + " ";
+        return result + items[count - 2] + " CALL";
+    }
+    if (last == "=") {
+        //  =
+        const std::string& name = items[0];
+        if (!foldExpression(items, 1, count - 1, stack) || stack.size() != 1) {
+            values.erase(name);
+            return line;
+        }
+
+        Operand value = stack[0];
+        auto type = types.find(name);
+        values.erase(name);
+        if (value.constant && type != types.end()) {
+            //    
+            if (type->second == TT_REAL && value.type == TT_INTEGER) {
+                value.realValue = (double)value.intValue;
+                value.type = TT_REAL;
+            }
+            if (type->second == value.type) values[name] = value;
+        }
+        return name + " " + operandText(value) + " =";
+    }
+    return line;
+}
\ No newline at end of file
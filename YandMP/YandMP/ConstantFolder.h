@@ -0,0 +1,44 @@
+#pragma once
+#include "Token.h"
+#include "ConstantPool.h"
+#include <map>
+#include <string>
+#include <vector>
+
+//        .
+//    ( ):  "a 4556 ="
+// a        
+//  a   
+class ConstantFolder {
+public:
+    ConstantFolder() : constants(nullptr) {}
+
+    //     ,    
+    void setConstants(ConstantPool* pool) { constants = pool; }
+
+    //   ;     
+    std::string fold(const std::string& line);
+
+    // ,           
+    static std::string constantText(TokenType type, long long intValue, double realValue);
+
+private:
+    //  :     
+    struct Operand {
+        bool constant;
+        TokenType type;
+        long long intValue;
+        double realValue;
+        std::string text;
+    };
+
+    std::map<std::string, TokenType> types;     //  
+    std::map<std::string, Operand> values;      //   
+    ConstantPool* constants;
+
+    Operand constantOperand(const std::string& item) const;
+
+    bool foldExpression(const std::vector<std::string>& items, size_t from, size_t to,
+        std::vector<Operand>& stack) const;
+    std::string operandText(const Operand& operand) const;
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "Token.h"
+#include <string>
+#include <unordered_map>
+
+//  :   -> ,   .
+// ;      ,  
+//         .
+//     base:    base,  
+//     -      
+class ConstantPool {
+public:
+    explicit ConstantPool(const ConstantPool* parent = nullptr) : base(parent) {}
+
+    struct Value {
+        TokenType type;
+        long long intValue;
+        double realValue;
+    };
+
+    void add(const std::string& text, TokenType type, long long intValue, double realValue) {
+        values.emplace(text, Value{ type, intValue, realValue });
+    }
+
+    const Value* find(const std::string& text) const {
+        auto it = values.find(text);
+        if (it != values.end()) return &it->second;
+        return base ? base->find(text) : nullptr;
+    }
+
+    //    
+    void merge(const ConstantPool& other) {
+        values.insert(other.values.begin(), other.values.end());
+    }
+
+    size_t size() const { return values.size(); }
+
+private:
+    const ConstantPool* base;
+    std::unordered_map<std::string, Value> values;
+};
\ No newline at end of file
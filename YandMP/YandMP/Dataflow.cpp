@@ -0,0 +1,131 @@
+#include "Dataflow.h"
+#include "ObjectCode.h"
+#include <cctype>
+
+static bool isVariable(const std::string& item) {
+    if (item.empty() || postfixArity(item) > 0) return false;
+    size_t start = item.size() > 1 && item[0] == '-' ? 1 : 0;
+    return !std::isdigit((unsigned char)item[start]);
+}
+
+Dataflow::Dataflow(const std::vector<std::string>& postfix, const std::vector<int>& lines)
+    : deadStores(0) {
+    parse(postfix);
+    reachingDefinitions(lines);
+}
+
+void Dataflow::parse(const std::vector<std::string>& postfix) {
+    for (const auto& line : postfix) {
+        Statement stmt{ ST_OTHER, splitPostfix(line), "", {}, true };
+        const std::string& last = stmt.items.back();
+        size_t count = stmt.items.size();
+
+        if (last == "DECL" || last == "DIM") {
+            //  ... N DECL |    DIM:       
+            stmt.kind = ST_DECL;
+        }
+        else if (last == "CALL" && count >= 3) {
+            // ... N CALL
+            stmt.kind = ST_CALL;
+            for (size_t i = 1; i + 2 < count; i++) {
+                if (isVariable(stmt.items[i])) stmt.uses.push_back(stmt.items[i]);
+            }
+        }
+        else if (last == "=" && count >= 2) {
+            //  =
+            stmt.kind = ST_ASSIGN;
+            stmt.def = stmt.items[0];
+            for (size_t i = 1; i + 1 < count; i++) {
+                if (isVariable(stmt.items[i])) stmt.uses.push_back(stmt.items[i]);
+            }
+        }
+        statements.push_back(stmt);
+    }
+}
+
+//     ,    
+void Dataflow::reachingDefinitions(const std::vector<int>& lines) {
+    std::set<std::string> declared;
+    std::set<std::string> defined;
+
+    for (size_t n = 0; n < statements.size(); n++) {
+        const Statement& stmt = statements[n];
+
+        if (stmt.kind == ST_DECL) {
+            for (size_t i = 1; i + 2 < stmt.items.size(); i++) declared.insert(stmt.items[i]);
+            continue;
+        }
+
+        std::set<std::string> reported;
+        for (const auto& name : stmt.uses) {
+            if (declared.count(name) && !defined.count(name) && reported.insert(name).second) {
+                int line = n < lines.size() ? lines[n] : -1;
+                warnings.push_back("WARNING at line " + std::to_string(line) + ": Variable '" + name +
+                    "' is used before initialization");
+            }
+        }
+        if (stmt.kind == ST_ASSIGN) defined.insert(stmt.def);
+    }
+}
+
+void Dataflow::liveness() {
+    std::set<std::string> live;     //,    
+
+    for (size_t n = statements.size(); n-- > 0;) {
+        Statement& stmt = statements[n];
+
+        if (stmt.kind == ST_ASSIGN) {
+            if (!live.count(stmt.def)) {
+                stmt.live = false;
+                deadStores++;
+                continue;
+            }
+            live.erase(stmt.def);
+        }
+        live.insert(stmt.uses.begin(), stmt.uses.end());
+    }
+}
+
+void Dataflow::eliminateDeadCode(std::vector<std::string>& postfix, std::vector<int>& lines) {
+    liveness();
+
+    //,        
+    std::set<std::string> used;
+    for (const auto& stmt : statements) {
+        if (!stmt.live) continue;
+        if (stmt.kind == ST_ASSIGN) used.insert(stmt.def);
+        used.insert(stmt.uses.begin(), stmt.uses.end());
+    }
+
+    std::vector<std::string> newPostfix;
+    std::vector<int> newLines;
+    for (size_t n = 0; n < statements.size(); n++) {
+        const Statement& stmt = statements[n];
+        int line = n < lines.size() ? lines[n] : -1;
+        if (!stmt.live) continue;
+
+        if (stmt.kind == ST_DECL && stmt.items.back() == "DIM") {
+            if (!used.count(stmt.items[1])) continue;
+            newPostfix.push_back(postfix[n]);
+        }
+        else if (stmt.kind == ST_DECL) {
+            //  ... N DECL:    
+            std::string decl = stmt.items[0];
+            size_t names = 0;
+            for (size_t i = 1; i + 2 < stmt.items.size(); i++) {
+                if (!used.count(stmt.items[i])) continue;
+                decl += " " + stmt.items[i];
+                names++;
+            }
+            if (names == 0) continue;
+            newPostfix.push_back(decl + " " + std::to_string(names + 1) + " DECL");
+        }
+        else {
+            newPostfix.push_back(postfix[n]);
+        }
+        newLines.push_back(line);
+    }
+
+    postfix.swap(newPostfix);
+    lines.swap(newLines);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <set>
+#include <string>
+#include <vector>
+
+//       .
+// :  ,      .
+// ( ): ,     
+//        , .
+//   -   
+class Dataflow {
+public:
+    Dataflow(const std::vector<std::string>& postfix, const std::vector<int>& lines);
+
+    //    
+    const std::vector<std::string>& getWarnings() const { return warnings; }
+
+    //      ;
+    //   ,    
+    void eliminateDeadCode(std::vector<std::string>& postfix, std::vector<int>& lines);
+
+    size_t getDeadStores() const { return deadStores; }
+
+private:
+    enum Kind { ST_OTHER, ST_DECL, ST_ASSIGN, ST_CALL };
+
+    struct Statement {
+        Kind kind;
+        std::vector<std::string> items;
+        std::string def;                    // 
+        std::vector<std::string> uses;      // 
+        bool live;
+    };
+
+    std::vector<Statement> statements;
+    std::vector<std::string> warnings;
+    size_t deadStores;
+
+    void parse(const std::vector<std::string>& postfix);
+    void reachingDefinitions(const std::vector<int>& lines);
+    void liveness();
+};
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "Diagnostic.h"
+
+//         
+const char* diagnosticMessage(DiagCode code) {
+    switch (code) {
+    case DIAG_EXPECTED_STATEMENT: return "Expected statement";
+    case DIAG_EXPECTED_END_STATEMENT: return "Expected END statement";
+    case DIAG_UNEXPECTED_AFTER_END: return "Unexpected token(s) after END";
+    case DIAG_EXPECTED_PROGRAM_ID: return "Expected identifier after PROGRAM";
+    case DIAG_EXPECTED_PROGRAM: return "Expected 'PROGRAM'";
+    case DIAG_EXPECTED_TYPE: return "Expected 'INTEGER' or 'REAL'";
+    case DIAG_EXPECTED_ID_AFTER_COMMA: return "Expected identifier after comma";
+    case DIAG_EXPECTED_ID_IN_LIST: return "Expected identifier in variable list";
+    case DIAG_UNEXPECTED_ASSIGN: return "Unexpected '=' after expression";
+    case DIAG_EXPECTED_ASSIGN: return "Expected '=' in assignment";
+    case DIAG_EXPECTED_RPAREN_ARGS: return "Expected ')' after arguments";
+    case DIAG_EXPECTED_LPAREN: return "Expected '(' after CALL identifier";
+    case DIAG_EXPECTED_CALL_ID: return "Expected identifier after CALL";
+    case DIAG_UNEXPECTED_EOF_EXPR: return "Unexpected end of input in expression";
+    case DIAG_EXPECTED_RPAREN_EXPR: return "Expected ')' after expression";
+    case DIAG_MISSING_OPERAND: return "Missing operand in expression";
+    case DIAG_EXPECTED_OPERAND: return "Expected identifier, constant, or '('";
+    case DIAG_EXPECTED_END_ID: return "Expected identifier after END";
+    case DIAG_EXPECTED_END: return "Expected 'END'";
+    case DIAG_EXPECTED_ARRAY_SIZE: return "Expected integer array size after '('";
+    case DIAG_EXPECTED_RPAREN_SIZE: return "Expected ')' after array size";
+    default: return "";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include "Token.h"
+#include <cstddef>
+#include <string>
+
+//    
+enum DiagCode {
+    //
+    DIAG_EXPECTED_STATEMENT,
+    DIAG_EXPECTED_END_STATEMENT,
+    DIAG_UNEXPECTED_AFTER_END,
+    DIAG_EXPECTED_PROGRAM_ID,
+    DIAG_EXPECTED_PROGRAM,
+    DIAG_EXPECTED_TYPE,
+    DIAG_EXPECTED_ID_AFTER_COMMA,
+    DIAG_EXPECTED_ID_IN_LIST,
+    DIAG_UNEXPECTED_ASSIGN,
+    DIAG_EXPECTED_ASSIGN,
+    DIAG_EXPECTED_RPAREN_ARGS,
+    DIAG_EXPECTED_LPAREN,
+    DIAG_EXPECTED_CALL_ID,
+    DIAG_UNEXPECTED_EOF_EXPR,
+    DIAG_EXPECTED_RPAREN_EXPR,
+    DIAG_MISSING_OPERAND,
+    DIAG_EXPECTED_OPERAND,
+    DIAG_EXPECTED_END_ID,
+    DIAG_EXPECTED_END,
+    DIAG_EXPECTED_ARRAY_SIZE,
+    DIAG_EXPECTED_RPAREN_SIZE,
+
+    //
+    DIAG_NOT_DECLARED,
+    DIAG_ALREADY_DECLARED,
+    DIAG_TYPE_MISMATCH,
+    DIAG_PROGRAM_NAME_MISMATCH,
+    DIAG_INVALID_ARRAY_SIZE,
+    DIAG_ARRAY_SIZE_MISMATCH,       //     
+    DIAG_ARRAY_ASSIGN_MISMATCH,     //      
+    DIAG_ARRAY_TO_SCALAR
+};
+
+//   ,   
+const int DIAG_AT_EOF = -1;         // 
+const int DIAG_EMPTY_FILE = -2;     //  
+
+//     ,     .
+//   :      
+struct Diagnostic {
+    DiagCode code;
+    int line;
+    int token;                  //:    DIAG_AT_EOF / DIAG_EMPTY_FILE
+    std::string name;           //:    ,  - 
+    TokenType leftType;         // :  
+    TokenType rightType;        //  
+};
+
+//      . compileFile    
+//    ,     
+class ErrorBudget {
+public:
+    explicit ErrorBudget(size_t maxErrors = 0) : limit(maxErrors), used(0) {}
+
+    //,    :   
+    static ErrorBudget spent() {
+        ErrorBudget budget(1);
+        budget.used = 1;
+        return budget;
+    }
+
+    //    ; false -   ,   
+    bool reserve() {
+        if (limit > 0 && used >= limit) return false;
+        used++;
+        return true;
+    }
+    bool isSpent() const { return limit > 0 && used >= limit; }
+
+private:
+    size_t limit;               //0 -  
+    size_t used;
+};
+
+//  
+const char* diagnosticMessage(DiagCode code);
\ No newline at end of file
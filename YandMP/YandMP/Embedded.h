@@ -0,0 +1,608 @@
+#pragma once
+#include "ObjectCode.h"
+#include "Diagnostic.h"
+#include "Semantic.h"
+#include <array>
+#include <cfloat>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+//,      C++     .
+//,       
+// constexpr,  -      :
+//
+//    YAMP_EMBED(sample, "PROGRAM p INTEGER a a = 1 + 2 CALL Print(a) END p");
+//    ObjectCode object;
+//    sample.load(object);
+//
+//, ,      ObjectCode::build   
+//  -O.     EmbeddedError   
+//constexpr,    ,     
+//embeddedRequire:         
+
+// :      Diagnostic.h
+enum EmbeddedLexError {
+    EMBED_BAD_CHARACTER,
+    EMBED_BAD_NUMBER,           //       
+    EMBED_INTEGER_RANGE,
+    EMBED_REAL_DIGITS,          // DBL_DECIMAL_DIG  
+    EMBED_REAL_RANGE
+};
+
+struct EmbeddedError {
+    int code;
+    int line;
+};
+
+constexpr void embeddedRequire(bool condition, DiagCode code, int line) {
+    if (!condition) throw EmbeddedError{ (int)code, line };
+}
+
+constexpr void embeddedRequire(bool condition, EmbeddedLexError code, int line) {
+    if (!condition) throw EmbeddedError{ (int)code, line };
+}
+
+// :    ,     
+struct EmbeddedSizes {
+    size_t code;
+    size_t constants;
+    size_t symbols;
+    size_t lines;
+    size_t strings;
+};
+
+//   (ObjectCode.h);  -  ,   
+template <size_t CODE, size_t CONSTS, size_t SYMBOLS, size_t LINES, size_t STRINGS>
+struct EmbeddedProgram {
+    std::array<ObjInstr, CODE> code;
+    std::array<ObjConst, CONSTS> constants;
+    std::array<ObjSymbol, SYMBOLS> symbols;
+    std::array<ObjLine, LINES> lines;
+    std::array<char, STRINGS> strings;
+
+    //     double  constexpr  :
+    //       ,   ObjectCode::build
+    bool load(ObjectCode& object) const {
+        std::vector<ObjConst> values(constants.begin(), constants.end());
+        for (auto& value : values) {
+            if (value.type == TT_REAL) {
+                value.realValue = std::strtod(std::string(strings.data() + value.text, value.textLength).c_str(), nullptr);
+            }
+        }
+        return object.load(ObjTables{ code.data(), (uint32_t)CODE, values.data(), (uint32_t)CONSTS,
+            symbols.data(), (uint32_t)SYMBOLS, lines.data(), (uint32_t)LINES, strings.data(), (uint32_t)STRINGS });
+    }
+};
+
+//   N  (  ).  Lexer, Synt 
+//SemanticAnalyzer        .
+//     :   N ,   
+//   ( "REAL a" - TYPE, SYMBOL, COUNT, DECL)
+template <size_t N>
+class EmbeddedCompiler {
+public:
+    constexpr explicit EmbeddedCompiler(const char (&source)[N]) : text(source) {}
+
+    constexpr void compile() {
+        tokenize();
+        parseProgram();
+    }
+
+    constexpr EmbeddedSizes sizes() const {
+        size_t strings = 0;
+        for (size_t i = 0; i < constCount; i++) strings += consts[i].length;
+        for (size_t i = 0; i < symbolCount; i++) strings += syms[i].length;
+        return EmbeddedSizes{ codeCount, constCount, symbolCount, lineCount, strings };
+    }
+
+    //     ObjectCode::write
+    template <class Program>
+    constexpr void copyTo(Program& program) const {
+        uint32_t offset = 0;
+        for (size_t i = 0; i < codeCount; i++) program.code[i] = code[i];
+        for (size_t i = 0; i < constCount; i++) {
+            const Name& c = consts[i];
+            program.constants[i] = ObjConst{ (uint32_t)c.type, offset, c.length, 0, c.intValue,
+                c.type == TT_INTEGER ? (double)c.intValue : 0.0 };
+            for (uint32_t k = 0; k < c.length; k++) program.strings[offset++] = text[c.start + k];
+        }
+        for (size_t i = 0; i < symbolCount; i++) {
+            const Name& s = syms[i];
+            program.symbols[i] = ObjSymbol{ offset, s.length, (uint32_t)s.kind, (uint32_t)s.type };
+            for (uint32_t k = 0; k < s.length; k++) program.strings[offset++] = text[s.start + k];
+        }
+        for (size_t i = 0; i < lineCount; i++) program.lines[i] = lines[i];
+    }
+
+private:
+    enum Keyword { KW_NONE, KW_PROGRAM, KW_INTEGER, KW_REAL, KW_END, KW_CALL };
+
+    struct Tok {
+        TokenType type;
+        Keyword keyword;
+        uint32_t start;
+        uint32_t length;
+        int line;
+        long long intValue;     // TT_INTEGER
+    };
+
+    //   : ,     
+    struct Name {
+        uint32_t start;
+        uint32_t length;
+        TokenType type;
+        int size;               // , 0 - 
+        SymbolKind kind;
+        long long intValue;
+    };
+
+    //  : OP_SYMBOL, OP_CONST  
+    struct Item {
+        OpCode op;
+        uint32_t start;
+        uint32_t length;
+        TokenType type;
+        int size;
+    };
+
+    struct Operand {
+        TokenType type;
+        size_t start;
+        int size;
+    };
+
+    static constexpr size_t CODE = 2 * N;
+    static constexpr int OPEN_PAREN = -1;
+
+    const char* text;
+    size_t length = N - 1;
+
+    Tok tokens[N] = {};
+    size_t tokenCount = 0;
+    size_t pos = 0;
+
+    Name vars[N] = {};
+    size_t varCount = 0;
+    Name program = {};
+
+    Item raw[N] = {};           //     
+    size_t rawCount = 0;
+    Item typed[CODE] = {};      //  
+    size_t typedCount = 0;
+    int operators[N] = {};      //OpCode   OPEN_PAREN
+    size_t operatorCount = 0;
+    Operand operands[N] = {};
+    bool convertAfter[N] = {};
+    size_t decls[N] = {};       //   
+
+    ObjInstr code[CODE] = {};
+    size_t codeCount = 0;
+    Name consts[N] = {};
+    size_t constCount = 0;
+    Name syms[N] = {};
+    size_t symbolCount = 0;
+    ObjLine lines[N] = {};
+    size_t lineCount = 0;
+
+    static constexpr bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+    static constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+    static constexpr char upper(char c) { return c >= 'a' && c <= 'z' ? (char)(c - 'a' + 'A') : c; }
+
+    constexpr bool sameText(uint32_t a, uint32_t aLength, uint32_t b, uint32_t bLength) const {
+        if (aLength != bLength) return false;
+        for (uint32_t k = 0; k < aLength; k++) {
+            if (text[a + k] != text[b + k]) return false;
+        }
+        return true;
+    }
+
+    //    ,   Lexer
+    constexpr Keyword keyword(uint32_t start, uint32_t count) const {
+        const char* words[] = { "PROGRAM", "INTEGER", "REAL", "END", "CALL" };
+        for (int w = 0; w < 5; w++) {
+            uint32_t k = 0;
+            while (k < count && words[w][k] != '\0' && upper(text[start + k]) == words[w][k]) k++;
+            if (k == count && words[w][k] == '\0') return (Keyword)(w + 1);
+        }
+        return KW_NONE;
+    }
+
+    //Lexer::scanToken
+    constexpr void tokenize() {
+        int line = 1;
+        size_t i = 0;
+        while (i < length) {
+            char c = text[i];
+            if (isSpace(c)) {
+                if (c == '\n') line++;
+                i++;
+                continue;
+            }
+
+            Tok tok{ TT_UNKNOWN, KW_NONE, (uint32_t)i, 0, line, 0 };
+            if (isAlpha(c)) {
+                while (i < length && isAlpha(text[i])) i++;
+                tok.length = (uint32_t)(i - tok.start);
+                tok.keyword = keyword(tok.start, tok.length);
+                tok.type = tok.keyword != KW_NONE ? TT_KEYWORD : TT_IDENTIFIER;
+            }
+            else if (isDigit(c)) {
+                bool bad = false;
+                if (c == '0') {
+                    i++;
+                    bad = i < length && isDigit(text[i]);
+                }
+                while (i < length && isDigit(text[i])) i++;
+                tok.type = TT_INTEGER;
+                if (i < length && text[i] == '.') {
+                    i++;
+                    bad = bad || i >= length || !isDigit(text[i]);
+                    while (i < length && isDigit(text[i])) i++;
+                    tok.type = TT_REAL;
+                }
+                embeddedRequire(!bad, EMBED_BAD_NUMBER, line);
+                tok.length = (uint32_t)(i - tok.start);
+                if (tok.type == TT_INTEGER) tok.intValue = decodeInteger(tok);
+                else checkReal(tok);
+            }
+            else {
+                i++;
+                tok.length = 1;
+                switch (c) {
+                case '=': tok.type = TT_ASSIGN; break;
+                case '+': tok.type = TT_PLUS; break;
+                case '-': tok.type = TT_MINUS; break;
+                case ',': tok.type = TT_COMMA; break;
+                case '(': tok.type = TT_LPAREN; break;
+                case ')': tok.type = TT_RPAREN; break;
+                default: embeddedRequire(false, EMBED_BAD_CHARACTER, line);
+                }
+            }
+            tokens[tokenCount++] = tok;
+        }
+    }
+
+    constexpr long long decodeInteger(const Tok& tok) const {
+        long long value = 0;
+        for (uint32_t k = 0; k < tok.length; k++) {
+            int digit = text[tok.start + k] - '0';
+            embeddedRequire(value <= (LLONG_MAX - digit) / 10, EMBED_INTEGER_RANGE, tok.line);
+            value = value * 10 + digit;
+        }
+        return value;
+    }
+
+    // Lexer::decodeNumber   .   
+    //  DBL_DECIMAL_DIG    : DBL_MAX  
+    //   (   )
+    constexpr void checkReal(const Tok& tok) const {
+        int intDigits = 0;
+        int first = -1;
+        int last = -1;
+        int digits = 0;
+        for (uint32_t k = 0; k < tok.length; k++) {
+            char c = text[tok.start + k];
+            if (c == '.') {
+                intDigits = digits;
+                continue;
+            }
+            if (c != '0') {
+                if (first < 0) first = digits;
+                last = digits;
+            }
+            digits++;
+        }
+        if (first < 0) return;
+        embeddedRequire(last - first + 1 <= DBL_DECIMAL_DIG, EMBED_REAL_DIGITS, tok.line);
+
+        unsigned long long significand = 0;
+        for (int d = 0, k = 0; d < DBL_DECIMAL_DIG; d++) {
+            int digit = 0;
+            if (first + d <= last) {
+                // :   first + d    
+                k = first + d < intDigits ? first + d : first + d + 1;
+                digit = text[tok.start + k] - '0';
+            }
+            significand = significand * 10 + digit;
+        }
+        int exponent = intDigits - 1 - first;
+        embeddedRequire(exponent < 308 || (exponent == 308 && significand <= 17976931348623158ULL),
+            EMBED_REAL_RANGE, tok.line);
+        embeddedRequire(exponent > -324 || (exponent == -324 && significand > 24703282292062327ULL),
+            EMBED_REAL_RANGE, tok.line);
+    }
+
+    constexpr int line() const {
+        if (tokenCount == 0) return 1;
+        return tokens[pos < tokenCount ? pos : tokenCount - 1].line;
+    }
+
+    constexpr bool at(TokenType type) const { return pos < tokenCount && tokens[pos].type == type; }
+    constexpr bool atKeyword(Keyword word) const { return pos < tokenCount && tokens[pos].keyword == word; }
+
+    constexpr bool match(TokenType type) {
+        if (!at(type)) return false;
+        pos++;
+        return true;
+    }
+
+    constexpr const Tok& expect(TokenType type, DiagCode code) {
+        embeddedRequire(at(type), code, line());
+        return tokens[pos++];
+    }
+
+    constexpr int findVar(const Tok& tok) const {
+        for (size_t i = 0; i < varCount; i++) {
+            if (sameText(vars[i].start, vars[i].length, tok.start, tok.length)) return (int)i;
+        }
+        return -1;
+    }
+
+    //ObjectCode::addConst  addSymbol:   ,  -   
+    constexpr uint32_t addConst(const Item& item) {
+        for (size_t i = 0; i < constCount; i++) {
+            if (sameText(consts[i].start, consts[i].length, item.start, item.length)) return (uint32_t)i;
+        }
+        long long value = 0;
+        for (uint32_t k = 0; item.type == TT_INTEGER && k < item.length; k++) value = value * 10 + (text[item.start + k] - '0');
+        consts[constCount] = Name{ item.start, item.length, item.type, 0, SYM_VARIABLE, value };
+        return (uint32_t)constCount++;
+    }
+
+    constexpr uint32_t addSymbol(uint32_t start, uint32_t count, SymbolKind kind, TokenType type = TT_UNKNOWN) {
+        for (size_t i = 0; i < symbolCount; i++) {
+            if (syms[i].kind == kind && sameText(syms[i].start, syms[i].length, start, count)) {
+                if (syms[i].type == TT_UNKNOWN) syms[i].type = type;
+                return (uint32_t)i;
+            }
+        }
+        syms[symbolCount] = Name{ start, count, type, 0, kind, 0 };
+        return (uint32_t)symbolCount++;
+    }
+
+    constexpr void beginLine(int sourceLine) {
+        lines[lineCount++] = ObjLine{ (uint32_t)codeCount, sourceLine };
+    }
+
+    constexpr void emit(OpCode op, uint32_t arg = 0) {
+        code[codeCount++] = ObjInstr{ (uint32_t)op, arg };
+    }
+
+    constexpr void emitExpressions() {
+        for (size_t i = 0; i < typedCount; i++) {
+            const Item& item = typed[i];
+            if (item.op == OP_SYMBOL) emit(OP_SYMBOL, addSymbol(item.start, item.length, SYM_VARIABLE));
+            else if (item.op == OP_CONST) emit(OP_CONST, addConst(item));
+            else emit(item.op);
+        }
+    }
+
+    //Program -> Begin Descriptions Operators End
+    constexpr void parseProgram() {
+        embeddedRequire(atKeyword(KW_PROGRAM), DIAG_EXPECTED_PROGRAM, line());
+        pos++;
+        const Tok& name = expect(TT_IDENTIFIER, DIAG_EXPECTED_PROGRAM_ID);
+        program = Name{ name.start, name.length, TT_UNKNOWN, 0, SYM_PROGRAM, 0 };
+        beginLine(name.line);
+        emit(OP_SYMBOL, addSymbol(name.start, name.length, SYM_PROGRAM));
+        emit(OP_PROGRAM);
+
+        while (atKeyword(KW_INTEGER) || atKeyword(KW_REAL)) parseDescr();
+        while (at(TT_IDENTIFIER) || atKeyword(KW_CALL)) parseOp();
+
+        embeddedRequire(atKeyword(KW_END), DIAG_EXPECTED_END, line());
+        pos++;
+        const Tok& end = expect(TT_IDENTIFIER, DIAG_EXPECTED_END_ID);
+        embeddedRequire(pos == tokenCount, DIAG_UNEXPECTED_AFTER_END, line());
+        embeddedRequire(sameText(program.start, program.length, end.start, end.length), DIAG_PROGRAM_NAME_MISMATCH, end.line);
+        beginLine(end.line);
+        emit(OP_SYMBOL, addSymbol(end.start, end.length, SYM_PROGRAM));
+        emit(OP_END);
+    }
+
+    //Descr -> Type VarList;    DECL,   -  DIM
+    constexpr void parseDescr() {
+        TokenType type = tokens[pos++].keyword == KW_INTEGER ? TT_INTEGER : TT_REAL;
+        size_t count = 0;
+        do {
+            const Tok& id = expect(TT_IDENTIFIER, count == 0 ? DIAG_EXPECTED_ID_IN_LIST : DIAG_EXPECTED_ID_AFTER_COMMA);
+            int size = 0;
+            if (match(TT_LPAREN)) {
+                const Tok& elements = expect(TT_INTEGER, DIAG_EXPECTED_ARRAY_SIZE);
+                expect(TT_RPAREN, DIAG_EXPECTED_RPAREN_SIZE);
+                embeddedRequire(elements.intValue >= 1 && elements.intValue <= MAX_ARRAY_SIZE, DIAG_INVALID_ARRAY_SIZE, id.line);
+                size = (int)elements.intValue;
+            }
+            embeddedRequire(findVar(id) < 0, DIAG_ALREADY_DECLARED, id.line);
+            vars[varCount++] = Name{ id.start, id.length, type, size, SYM_VARIABLE, 0 };
+            decls[count++] = (size_t)(&id - tokens);
+        } while (match(TT_COMMA));
+
+        //  -  count  
+        const Name* list = vars + varCount - count;
+        size_t scalars = 0;
+        for (size_t i = 0; i < count; i++) {
+            const Name& var = list[i];
+            if (var.size > 0) continue;
+            if (scalars++ == 0) {
+                beginLine(tokens[decls[i]].line);
+                emit(OP_TYPE, (uint32_t)type);
+            }
+            emit(OP_SYMBOL, addSymbol(var.start, var.length, SYM_VARIABLE, type));
+        }
+        if (scalars > 0) {
+            emit(OP_COUNT, (uint32_t)(scalars + 1));
+            emit(OP_DECL);
+        }
+        for (size_t i = 0; i < count; i++) {
+            const Name& var = list[i];
+            if (var.size == 0) continue;
+            beginLine(tokens[decls[i]].line);
+            emit(OP_TYPE, (uint32_t)type);
+            emit(OP_SYMBOL, addSymbol(var.start, var.length, SYM_VARIABLE, type));
+            emit(OP_COUNT, (uint32_t)var.size);
+            emit(OP_DIM);
+        }
+    }
+
+    //Op -> Id = Expr | CALL Id ( Expr, ... )
+    constexpr void parseOp() {
+        typedCount = 0;
+        if (at(TT_IDENTIFIER)) {
+            const Tok& id = tokens[pos++];
+            expect(TT_ASSIGN, DIAG_EXPECTED_ASSIGN);
+            int var = findVar(id);
+            embeddedRequire(var >= 0, DIAG_NOT_DECLARED, id.line);
+
+            Operand result = parseExpression(id.line);
+            embeddedRequire(!at(TT_ASSIGN), DIAG_UNEXPECTED_ASSIGN, line());
+            embeddedRequire(vars[var].type == result.type, DIAG_TYPE_MISMATCH, id.line);
+            embeddedRequire(result.size == 0 || vars[var].size > 0, DIAG_ARRAY_TO_SCALAR, id.line);
+            embeddedRequire(result.size == 0 || result.size == vars[var].size, DIAG_ARRAY_ASSIGN_MISMATCH, id.line);
+
+            beginLine(id.line);
+            emit(OP_SYMBOL, addSymbol(id.start, id.length, SYM_VARIABLE));
+            emitExpressions();
+            emit(OP_ASSIGN);
+        }
+        else {
+            int callLine = tokens[pos++].line;
+            const Tok& procedure = expect(TT_IDENTIFIER, DIAG_EXPECTED_CALL_ID);
+            expect(TT_LPAREN, DIAG_EXPECTED_LPAREN);
+            uint32_t arguments = 0;
+            if (pos < tokenCount && !at(TT_RPAREN)) {
+                do {
+                    parseExpression(callLine);
+                    arguments++;
+                } while (match(TT_COMMA));
+            }
+            expect(TT_RPAREN, DIAG_EXPECTED_RPAREN_ARGS);
+
+            beginLine(callLine);
+            emit(OP_SYMBOL, addSymbol(procedure.start, procedure.length, SYM_PROCEDURE));
+            emitExpressions();
+            emit(OP_COUNT, arguments + 1);
+            emit(OP_CALL);
+        }
+    }
+
+    //   ,   SemanticAnalyzer::convertToPostfix: 
+    //      ,    -  ")"
+    constexpr Operand parseExpression(int statementLine) {
+        rawCount = 0;
+        operatorCount = 0;
+        parseExpr();
+        while (operatorCount > 0) popOperator();
+
+        Operand result = typeExpression();
+        embeddedRequire(result.size >= 0, DIAG_ARRAY_SIZE_MISMATCH, statementLine);
+        return result;
+    }
+
+    constexpr void popOperator() {
+        raw[rawCount++] = Item{ (OpCode)operators[--operatorCount], 0, 0, TT_UNKNOWN, 0 };
+    }
+
+    //Expr -> SimpleExpr | SimpleExpr + Expr | SimpleExpr - Expr
+    constexpr void parseExpr() {
+        parseSimpleExpr();
+        while (at(TT_PLUS) || at(TT_MINUS)) {
+            operators[operatorCount++] = tokens[pos++].type == TT_PLUS ? OP_ADD : OP_SUB;
+            parseSimpleExpr();
+        }
+    }
+
+    //SimpleExpr -> Id | Const | ( Expr )
+    constexpr void parseSimpleExpr() {
+        embeddedRequire(pos < tokenCount, DIAG_UNEXPECTED_EOF_EXPR, line());
+        const Tok& tok = tokens[pos];
+        if (tok.type == TT_IDENTIFIER) {
+            int var = findVar(tok);
+            embeddedRequire(var >= 0, DIAG_NOT_DECLARED, tok.line);
+            raw[rawCount++] = Item{ OP_SYMBOL, tok.start, tok.length, vars[var].type, vars[var].size };
+            pos++;
+        }
+        else if (tok.type == TT_INTEGER || tok.type == TT_REAL) {
+            raw[rawCount++] = Item{ OP_CONST, tok.start, tok.length, tok.type, 0 };
+            pos++;
+        }
+        else if (tok.type == TT_LPAREN) {
+            pos++;
+            operators[operatorCount++] = OPEN_PAREN;
+            parseExpr();
+            expect(TT_RPAREN, DIAG_EXPECTED_RPAREN_EXPR);
+            while (operators[operatorCount - 1] != OPEN_PAREN) popOperator();
+            operatorCount--;
+        }
+        else {
+            bool missing = tok.type == TT_PLUS || tok.type == TT_MINUS || tok.type == TT_RPAREN || tok.type == TT_COMMA;
+            embeddedRequire(false, missing ? DIAG_MISSING_OPERAND : DIAG_EXPECTED_OPERAND, tok.line);
+        }
+    }
+
+    //SemanticAnalyzer::typePostfix:  , I2R    
+    //  ,    
+    constexpr Operand typeExpression() {
+        size_t depth = 0;
+        for (size_t i = 0; i < rawCount; i++) {
+            convertAfter[i] = false;
+            Item& item = raw[i];
+            if (item.op != OP_ADD && item.op != OP_SUB) {
+                operands[depth++] = Operand{ item.type, i, item.size };
+                continue;
+            }
+
+            Operand right = operands[--depth];
+            Operand& left = operands[depth - 1];
+            if (left.size < 0 || right.size < 0 || (left.size > 0 && right.size > 0 && left.size != right.size)) {
+                left.size = -1;
+            }
+            else {
+                left.size = left.size > right.size ? left.size : right.size;
+            }
+
+            bool real = left.type == TT_REAL || right.type == TT_REAL;
+            if (real && left.type == TT_INTEGER) convertAfter[right.start - 1] = true;
+            if (real && right.type == TT_INTEGER) convertAfter[i - 1] = true;
+
+            bool add = item.op == OP_ADD;
+            if (left.size != 0) item.op = add ? (real ? OP_VADD_R : OP_VADD_I) : (real ? OP_VSUB_R : OP_VSUB_I);
+            else item.op = add ? (real ? OP_ADD_R : OP_ADD_I) : (real ? OP_SUB_R : OP_SUB_I);
+            left.type = real ? TT_REAL : TT_INTEGER;
+        }
+
+        for (size_t i = 0; i < rawCount; i++) {
+            typed[typedCount++] = raw[i];
+            if (convertAfter[i]) typed[typedCount++] = Item{ OP_I2R, 0, 0, TT_REAL, 0 };
+        }
+        return operands[0];
+    }
+};
+
+template <size_t N>
+constexpr EmbeddedSizes embeddedSizes(const char (&source)[N]) {
+    EmbeddedCompiler<N> compiler(source);
+    compiler.compile();
+    return compiler.sizes();
+}
+
+template <size_t CODE, size_t CONSTS, size_t SYMBOLS, size_t LINES, size_t STRINGS, size_t N>
+constexpr EmbeddedProgram<CODE, CONSTS, SYMBOLS, LINES, STRINGS> embeddedCompile(const char (&source)[N]) {
+    EmbeddedCompiler<N> compiler(source);
+    compiler.compile();
+    EmbeddedProgram<CODE, CONSTS, SYMBOLS, LINES, STRINGS> program{};
+    compiler.copyTo(program);
+    return program;
+}
+
+//  name    source:   
+//,      
+#define YAMP_EMBED(name, source) \
+    static constexpr EmbeddedSizes name##Sizes = embeddedSizes(source); \
+    static constexpr auto name = embeddedCompile<name##Sizes.code, name##Sizes.constants, name##Sizes.symbols, \
+        name##Sizes.lines, name##Sizes.strings>(source)
@@ -0,0 +1,201 @@
+#include "ExpressionDag.h"
+#include "ObjectCode.h"
+#include <cctype>
+#include <cstdlib>
+
+std::string ExpressionDag::tempName(int temp) {
+    return "t" + std::to_string(temp + 1);
+}
+
+int ExpressionDag::leaf(const std::string& item) {
+    size_t start = item.size() > 1 && item[0] == '-' ? 1 : 0;
+    bool constant = std::isdigit((unsigned char)item[start]) != 0;
+
+    std::string key = constant ? "c:" + item : "v:" + item + "#" + std::to_string(versions[item]);
+    auto it = index.find(key);
+    if (it != index.end()) return it->second;
+
+    TokenType type = TT_UNKNOWN;
+    if (constant) {
+        type = item.find_first_of(".eE") != std::string::npos ? TT_REAL : TT_INTEGER;
+    }
+    else if (types.count(item)) {
+        type = types[item];
+    }
+
+    nodes.push_back(DagNode{ "", -1, -1, item, type, !constant && arrays.count(item) > 0, 0, -1 });
+    index.emplace(key, (int)nodes.size() - 1);
+    return (int)nodes.size() - 1;
+}
+
+int ExpressionDag::operation(const std::string& op, int left, int right) {
+    std::string key = op + ":" + std::to_string(left) + "," + std::to_string(right);
+    auto it = index.find(key);
+    if (it != index.end()) return it->second;
+
+    TokenType l = nodes[left].type;
+    TokenType r = right >= 0 ? nodes[right].type : TT_REAL;
+    TokenType type = TT_UNKNOWN;
+    if (right < 0) type = TT_REAL;
+    else if (l != TT_UNKNOWN && r != TT_UNKNOWN) type = l == TT_REAL || r == TT_REAL ? TT_REAL : TT_INTEGER;
+
+    bool array = nodes[left].array || (right >= 0 && nodes[right].array);
+    nodes.push_back(DagNode{ op, left, right, "", type, array, 0, -1 });
+    index.emplace(key, (int)nodes.size() - 1);
+    return (int)nodes.size() - 1;
+}
+
+// (   CALL) ->   
+bool ExpressionDag::build(const std::vector<std::string>& items, size_t from, size_t to, std::vector<int>& roots) {
+    for (size_t i = from; i < to; i++) {
+        const std::string& item = items[i];
+        if (item.empty()) return false;
+
+        int arity = postfixArity(item);
+        if (arity == 1) {
+            if (roots.empty()) return false;
+            roots.back() = operation(item, roots.back());
+        }
+        else if (arity == 2) {
+            if (roots.size() < 2) return false;
+            int right = roots.back();
+            roots.pop_back();
+            roots.back() = operation(item, roots.back(), right);
+        }
+        else {
+            roots.push_back(leaf(item));
+        }
+    }
+    return true;
+}
+
+//   ,     :
+//        
+void ExpressionDag::count(int id) {
+    DagNode& node = nodes[id];
+    if (node.op.empty()) return;
+    if (++node.uses == 1) {
+        count(node.left);
+        if (node.right >= 0) count(node.right);
+    }
+}
+
+std::string ExpressionDag::render(int id, std::vector<std::string>& before) {
+    DagNode& node = nodes[id];
+    if (node.op.empty()) return node.text;
+    if (node.temp >= 0) {
+        sharedNodes++;
+        return tempName(node.temp);
+    }
+
+    std::string expr = render(node.left, before);
+    if (node.right >= 0) expr += " " + render(node.right, before);
+    expr += " " + node.op;
+    //  ,  -   
+    if (node.uses < 2 || node.type == TT_UNKNOWN || node.array) return expr;
+
+    node.temp = (int)temporaries.size();
+    temporaries.push_back(node.type);
+    before.push_back(tempName(node.temp) + " " + expr + " =");
+    return tempName(node.temp);
+}
+
+void ExpressionDag::eliminate(std::vector<std::string>& postfix, std::vector<int>& lines) {
+    enum Kind { OTHER, ASSIGN, CALL };
+    std::vector<Kind> kinds(postfix.size(), OTHER);
+    std::vector<std::vector<int>> roots(postfix.size());
+    std::vector<std::vector<std::string>> items(postfix.size());
+    size_t declEnd = 0;     //     
+
+    //    
+    for (size_t n = 0; n < postfix.size(); n++) {
+        items[n] = splitPostfix(postfix[n]);
+        const auto& line = items[n];
+        const std::string& last = line.back();
+        size_t count = line.size();
+
+        if (last == "PROGRAM") {
+            declEnd = n + 1;
+        }
+        else if (last == "DECL") {
+            TokenType type = line[0] == "INTEGER" ? TT_INTEGER : TT_REAL;
+            for (size_t i = 1; i + 2 < count; i++) {
+                if (!types.count(line[i])) types[line[i]] = type;
+            }
+            declEnd = n + 1;
+        }
+        else if (last == "DIM") {
+            arrays.insert(line[1]);
+            declEnd = n + 1;
+        }
+        else if (last == "CALL" && count >= 3) {
+            if (build(line, 1, count - 2, roots[n]) && roots[n].size() + 1 == std::strtoul(line[count - 2].c_str(), nullptr, 10)) {
+                kinds[n] = CALL;
+            }
+        }
+        else if (last == "=" && count >= 3) {
+            if (build(line, 1, count - 1, roots[n]) && roots[n].size() == 1) kinds[n] = ASSIGN;
+            versions[line[0]]++;
+        }
+
+        if (kinds[n] == OTHER) {
+            roots[n].clear();
+        }
+        for (int root : roots[n]) {
+            this->count(root);
+        }
+    }
+
+    //:     
+    std::vector<std::string> newPostfix;
+    std::vector<int> newLines;
+    size_t declSlot = newPostfix.max_size();
+    int declLine = -1;
+    for (size_t n = 0; n < postfix.size(); n++) {
+        if (n == declEnd) {
+            //   ;   
+            declSlot = newPostfix.size();
+            declLine = n > 0 ? lines[n - 1] : -1;
+        }
+        if (kinds[n] == OTHER) {
+            newPostfix.push_back(postfix[n]);
+            newLines.push_back(lines[n]);
+            continue;
+        }
+
+        std::vector<std::string> before;
+        std::string text = items[n][0] + " ";
+        for (int root : roots[n]) {
+            text += render(root, before) + " ";
+        }
+        text += kinds[n] == CALL ? items[n][items[n].size() - 2] + " CALL" : "=";
+
+        for (const auto& line : before) {
+            newPostfix.push_back(line);
+            newLines.push_back(lines[n]);
+        }
+        newPostfix.push_back(text);
+        newLines.push_back(lines[n]);
+    }
+
+    // :     
+    std::vector<std::string> decls;
+    for (TokenType type : { TT_INTEGER, TT_REAL }) {
+        std::string decl = type == TT_INTEGER ? "INTEGER" : "REAL";
+        size_t names = 0;
+        for (size_t t = 0; t < temporaries.size(); t++) {
+            if (temporaries[t] != type) continue;
+            decl += " " + tempName((int)t);
+            names++;
+        }
+        if (names > 0) decls.push_back(decl + " " + std::to_string(names + 1) + " DECL");
+    }
+
+    if (declSlot <= newPostfix.size()) {
+        newPostfix.insert(newPostfix.begin() + declSlot, decls.begin(), decls.end());
+        newLines.insert(newLines.begin() + declSlot, decls.size(), declLine);
+    }
+
+    postfix.swap(newPostfix);
+    lines.swap(newLines);
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "Token.h"
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//  .       
+//  :   (   )
+//  . -   ,   
+// ,        
+// . ,   ,    
+//  (t1, t2, ... -       )
+class ExpressionDag {
+public:
+    ExpressionDag() : sharedNodes(0) {}
+
+    void eliminate(std::vector<std::string>& postfix, std::vector<int>& lines);
+
+    size_t getNodeCount() const { return nodes.size(); }
+    size_t getSharedNodes() const { return sharedNodes; }          // 
+    size_t getTemporaries() const { return temporaries.size(); }
+
+private:
+    struct DagNode {
+        std::string op;         //     
+        int left;
+        int right;              //-1   I2R
+        std::string text;       //    
+        TokenType type;
+        bool array;             // -  (   DIM)
+        int uses;
+        int temp;               //  , -1 - 
+    };
+
+    std::vector<DagNode> nodes;
+    std::unordered_map<std::string, int> index;         //  -> 
+    std::map<std::string, int> versions;
+    std::map<std::string, TokenType> types;
+    std::set<std::string> arrays;
+    std::vector<TokenType> temporaries;
+    size_t sharedNodes;
+
+    int leaf(const std::string& item);
+    int operation(const std::string& op, int left, int right = -1);
+    bool build(const std::vector<std::string>& items, size_t from, size_t to, std::vector<int>& roots);
+    void count(int id);
+    std::string render(int id, std::vector<std::string>& before);
+    static std::string tempName(int temp);
+};
\ No newline at end of file
@@ -0,0 +1,620 @@
+#include "Incremental.h"
+#include "Lexer.h"
+#include "HashTable.h"
+#include "Dataflow.h"
+#include "Linker.h"
+#include "Memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+//      
+static bool readSource(const std::string& path, std::string& result, std::vector<size_t>& starts) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    in.seekg(0, std::ios::end);
+    result.resize((size_t)in.tellg());
+    in.seekg(0, std::ios::beg);
+    in.read(&result[0], result.size());
+
+    starts.clear();
+    starts.push_back(0);
+    const char* data = result.data();
+    const char* end = data + result.size();
+    for (const char* p = data; (p = (const char*)std::memchr(p, '\n', end - p)) != nullptr; p++) {
+        starts.push_back(p - data + 1);
+    }
+    return true;
+}
+
+//  from..to (  1,  )
+static std::string sliceLines(const std::string& source, const std::vector<size_t>& starts, int from, int to) {
+    if (from > to) return "";
+    size_t begin = starts[from - 1];
+    size_t end = (size_t)to < starts.size() ? starts[to] - 1 : source.size();
+    return source.substr(begin, end - begin);
+}
+
+//  :    Id  '='
+static bool startsStatement(const std::vector<Token>& tokenList, size_t i) {
+    if (tokenList[i].getType() == TT_KEYWORD) return true;
+    return tokenList[i].getType() == TT_IDENTIFIER && i + 1 < tokenList.size() &&
+        tokenList[i + 1].getType() == TT_ASSIGN;
+}
+
+static bool hasLexicalErrors(const std::vector<Token>& tokenList) {
+    for (const auto& token : tokenList) {
+        if (token.getType() == TT_ERROR) return true;
+    }
+    return false;
+}
+
+static void deleteTree(Node* node) {
+    if (!node) return;
+    for (auto child : node->children) {
+        deleteTree(child);
+    }
+    delete node;
+}
+
+static void shiftTreeLines(Node* node, int delta) {
+    if (node->lineNumber >= 0) node->lineNumber += delta;
+    for (auto child : node->children) {
+        shiftTreeLines(child, delta);
+    }
+}
+
+static void collectNames(Node* node, std::vector<std::string>& names) {
+    if (node->name == "IDENTIFIER") {
+        names.push_back(node->value);
+    }
+    for (auto child : node->children) {
+        collectNames(child, names);
+    }
+}
+
+//      
+static std::vector<std::string> distinctLexemes(const std::vector<Statement*>& list, size_t from, size_t to) {
+    std::vector<std::string> result;
+    std::set<std::string> seen;
+    for (size_t i = from; i < to; i++) {
+        for (const auto& token : list[i]->tokens) {
+            if (seen.insert(token.getLexeme()).second) {
+                result.push_back(token.getLexeme());
+            }
+        }
+    }
+    return result;
+}
+
+//      offset
+static void patchFile(const std::string& path, size_t offset, const std::string& tail) {
+    if (offset == 0) {
+        std::ofstream out(path);
+        out << tail;
+        return;
+    }
+
+    std::fstream out(path, std::ios::in | std::ios::out | std::ios::binary);
+    out.seekp(offset);
+    out.write(tail.data(), tail.size());
+    out.close();
+
+    std::error_code ec;
+    std::filesystem::resize_file(path, offset + tail.size(), ec);
+}
+
+IncrementalCompiler::IncrementalCompiler(const CompileFiles& compileFiles)
+    : files(compileFiles), errorCount(0), valid(false), analyzer(nullptr), tableFullAt(0), recompiled(0), deadline(0) {
+}
+
+void IncrementalCompiler::setDeadline(long long milliseconds) {
+    deadline = milliseconds;
+    files.cancel = deadline > 0 ? &cancel : nullptr;
+}
+
+IncrementalCompiler::~IncrementalCompiler() {
+    freeStatements(statements, 0, statements.size());
+    delete analyzer;
+}
+
+void IncrementalCompiler::freeStatements(std::vector<Statement*>& list, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        deleteTree(list[i]->tree);
+        delete list[i];
+        list[i] = nullptr;
+    }
+}
+
+void IncrementalCompiler::applyLineDelta(Statement& stmt) {
+    if (stmt.lineDelta == 0) return;
+
+    for (auto& token : stmt.tokens) {
+        token.setLine(token.getLine() + stmt.lineDelta);
+    }
+    shiftTreeLines(stmt.tree, stmt.lineDelta);
+    stmt.lineDelta = 0;
+}
+
+bool IncrementalCompiler::parseStatement(Statement& stmt) {
+    std::ostringstream astOut;
+    Synt parser(stmt.tokens, astOut);
+    Node* tree = parser.parseStatement();
+
+    //      
+    if (!tree || !parser.getErrors().empty() || !parser.atEnd()) {
+        deleteTree(tree);
+        return false;
+    }
+
+    stmt.tree = tree;
+    stmt.astText = astOut.str();
+    stmt.firstLine = stmt.tokens.front().getLine();
+    stmt.lastLine = stmt.tokens.back().getLine();
+
+    if (tree->name == "Begin") stmt.rank = 0;
+    else if (tree->name == "Descr") stmt.rank = 1;
+    else if (tree->name == "Op") stmt.rank = 2;
+    else stmt.rank = 3;
+
+    collectNames(tree, stmt.names);
+    return true;
+}
+
+bool IncrementalCompiler::buildStatements(const std::vector<Token>& tokenList, std::vector<Statement*>& result) {
+    size_t start = 0;
+    while (start < tokenList.size()) {
+        if (!startsStatement(tokenList, start)) return false;
+
+        size_t end = start + 1;
+        while (end < tokenList.size() && !startsStatement(tokenList, end)) end++;
+
+        Statement* stmt = new Statement();
+        stmt->tokens.assign(tokenList.begin() + start, tokenList.begin() + end);
+        if (!parseStatement(*stmt)) {
+            delete stmt;
+            return false;
+        }
+        result.push_back(stmt);
+
+        start = end;
+    }
+    return true;
+}
+
+void IncrementalCompiler::analyzeStatement(size_t index) {
+    Statement& stmt = *statements[index];
+    applyLineDelta(stmt);
+
+    errorCount -= stmt.errors.size();
+    analyzer->analyzeStatement(stmt.tree, stmt.postfix, stmt.errors);
+    errorCount += stmt.errors.size();
+    analyzerOutput.str("");
+
+    postfixBytes[index] = 0;
+    for (const auto& line : stmt.postfix) {
+        postfixBytes[index] += line.size() + 1;
+    }
+    recompiled++;
+}
+
+//  :      
+void IncrementalCompiler::resetAnalyzer() {
+    delete analyzer;
+    analyzer = new SemanticAnalyzer(nullptr, analyzerOutput);
+
+    for (size_t i = 0; i < statements.size() && statements[i]->rank <= 1; i++) {
+        analyzeStatement(i);
+    }
+}
+
+//Begin,  ,    End (   Begin  End)
+bool IncrementalCompiler::ordered(size_t from, size_t to) const {
+    if (statements.size() < 2 || statements.front()->rank != 0 || statements.back()->rank != 3) {
+        return false;
+    }
+    for (size_t i = std::max<size_t>(from, 1); i < to; i++) {
+        int prev = statements[i - 1]->rank;
+        int cur = statements[i]->rank;
+        if (prev > cur || (prev == cur && (cur == 0 || cur == 3))) return false;
+    }
+    return true;
+}
+
+void IncrementalCompiler::fullRebuild(std::string& newText, std::vector<size_t>& newLineStarts) {
+    freeStatements(statements, 0, statements.size());
+    statements.clear();
+    errorCount = 0;
+    text.swap(newText);
+    lineStarts.swap(newLineStarts);
+
+    std::vector<Token> tokenList = Lexer::tokenize(text);
+    valid = !hasLexicalErrors(tokenList) && buildStatements(tokenList, statements) &&
+        ordered(0, statements.size());
+
+    // (ConstantFolder, ExpressionDag,   )        
+    valid = valid && !files.optimize;
+
+    if (!valid) {
+        //    :  ,   
+        freeStatements(statements, 0, statements.size());
+        statements.clear();
+        compileFile(files);
+        return;
+    }
+
+    astBytes.assign(statements.size(), 0);
+    postfixBytes.assign(statements.size(), 0);
+    for (size_t i = 0; i < statements.size(); i++) {
+        astBytes[i] = statements[i]->astText.size();
+    }
+
+    resetAnalyzer();
+    for (size_t i = 0; i < statements.size(); i++) {
+        if (statements[i]->rank > 1) analyzeStatement(i);
+    }
+
+    rebuildLexerText();
+    writeOutputs(0);
+}
+
+void IncrementalCompiler::update() {
+    auto started = std::chrono::steady_clock::now();
+
+    recompiled = 0;
+    bool incremental = false;
+    try {
+        //     
+        if (deadline > 0) cancel.setTimeout(deadline);
+        std::string newText;
+        std::vector<size_t> newLineStarts;
+        if (!readSource(files.inFile, newText, newLineStarts)) {
+            std::cerr << "Cannot open input file\n";
+            return;
+        }
+        incremental = valid && updateStatements(newText, newLineStarts);
+        if (!incremental) {
+            fullRebuild(newText, newLineStarts);
+        }
+    }
+    catch (const MemoryBudgetExceeded&) {
+        //   :     
+        valid = false;
+        std::cerr << "Compilation aborted: memory budget of " << MemoryTracker::getBudget() << " bytes exceeded" << std::endl;
+        return;
+    }
+    catch (const CompilationCancelled& cancelled) {
+        valid = false;
+        std::cerr << "Compilation aborted: " << cancelled.what() << " (" << deadline << " ms)" << std::endl;
+        return;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started);
+    if (incremental) {
+        std::cout << "Recompiled " << recompiled << " statement(s) in " << elapsed.count() << " ms" << std::endl;
+    }
+    else {
+        std::cout << "Full rebuild in " << elapsed.count() << " ms" << std::endl;
+    }
+}
+
+bool IncrementalCompiler::updateStatements(std::string& newText, std::vector<size_t>& newLineStarts) {
+    if (newText == text) return true;
+
+    //       ,   ,   
+    size_t common = std::min(text.size(), newText.size());
+    size_t head = std::mismatch(text.begin(), text.begin() + common, newText.begin()).first - text.begin();
+    size_t tail = std::mismatch(text.rbegin(), text.rbegin() + (common - head), newText.rbegin()).first - text.rbegin();
+
+    size_t oldCount = lineStarts.size();
+    size_t newCount = newLineStarts.size();
+    size_t prefix = std::upper_bound(lineStarts.begin(), lineStarts.end(), head) - lineStarts.begin() - 1;
+    size_t suffix = lineStarts.end() - std::upper_bound(lineStarts.begin(), lineStarts.end(), text.size() - tail);
+    suffix = std::min(suffix, std::min(oldCount, newCount) - prefix);
+
+    int delta = (int)newCount - (int)oldCount;
+    int lo = (int)prefix + 1;           //   : [lo, hi]
+    int hi = (int)(oldCount - suffix);  //   hi = lo - 1
+
+    //  [first, last)
+    size_t first = std::lower_bound(statements.begin(), statements.end(), lo,
+        [](const Statement* stmt, int line) { return stmt->lastLine < line; }) - statements.begin();
+    size_t last = first;
+
+    std::vector<Token> tokenList;
+    for (;;) {
+        while (last < statements.size() && statements[last]->firstLine <= hi) {
+            hi = std::max(hi, statements[last]->lastLine);
+            last++;
+        }
+        if (first < last) lo = std::min(lo, statements[first]->firstLine);
+
+        //      
+        while (first > 0 && statements[first - 1]->lastLine >= lo) {
+            first--;
+            lo = statements[first]->firstLine;
+        }
+
+        tokenList = Lexer::tokenize(sliceLines(newText, newLineStarts, lo, hi + delta), lo);
+
+        //     
+        if (!tokenList.empty() && !startsStatement(tokenList, 0) && first > 0) {
+            first--;
+            lo = statements[first]->firstLine;
+            continue;
+        }
+        break;
+    }
+
+    std::vector<Statement*> fresh;
+    if (hasLexicalErrors(tokenList) || !buildStatements(tokenList, fresh)) {
+        freeStatements(fresh, 0, fresh.size());
+        return false;
+    }
+
+    //  ,       
+    bool lexemesChanged = first < tableFullAt &&
+        distinctLexemes(statements, first, last) != distinctLexemes(fresh, 0, fresh.size());
+
+    //        
+    bool resetNeeded = false;
+    bool beginChanged = false;
+    std::set<std::string> changedNames;
+    auto noteChanged = [&](const Statement* stmt) {
+        if (stmt->rank == 0) beginChanged = true;
+        if (stmt->rank <= 1) {
+            resetNeeded = true;
+            changedNames.insert(stmt->names.begin(), stmt->names.end());
+        }
+    };
+    for (size_t i = first; i < last; i++) noteChanged(statements[i]);
+    for (auto stmt : fresh) noteChanged(stmt);
+
+    //      
+    std::vector<size_t> stale;
+    if (delta != 0) {
+        for (size_t i = last; i < statements.size(); i++) {
+            Statement* stmt = statements[i];
+            stmt->firstLine += delta;
+            stmt->lastLine += delta;
+            stmt->lineDelta += delta;
+
+            //    
+            if (!stmt->errors.empty()) {
+                if (stmt->rank <= 1) resetNeeded = true;
+                else stale.push_back(i);
+            }
+        }
+    }
+
+    for (size_t i = first; i < last; i++) {
+        errorCount -= statements[i]->errors.size();
+    }
+    freeStatements(statements, first, last);
+    statements.erase(statements.begin() + first, statements.begin() + last);
+    statements.insert(statements.begin() + first, fresh.begin(), fresh.end());
+
+    std::vector<size_t> freshBytes;
+    for (auto stmt : fresh) {
+        freshBytes.push_back(stmt->astText.size());
+    }
+    astBytes.erase(astBytes.begin() + first, astBytes.begin() + last);
+    astBytes.insert(astBytes.begin() + first, freshBytes.begin(), freshBytes.end());
+    postfixBytes.erase(postfixBytes.begin() + first, postfixBytes.begin() + last);
+    postfixBytes.insert(postfixBytes.begin() + first, fresh.size(), 0);
+    size_t freshEnd = first + fresh.size();
+    for (auto& index : stale) index = index - last + freshEnd;
+
+    if (!ordered(first, std::min(statements.size(), freshEnd + 1))) return false;
+    text.swap(newText);
+    lineStarts.swap(newLineStarts);
+
+    if (resetNeeded) {
+        resetAnalyzer();
+    }
+
+    std::vector<size_t> pending;
+    for (size_t i = first; i < freshEnd; i++) {
+        if (statements[i]->rank > 1) pending.push_back(i);
+    }
+    pending.insert(pending.end(), stale.begin(), stale.end());
+
+    //,    ,  End    
+    if (!changedNames.empty() || beginChanged) {
+        for (size_t i = 0; i < statements.size(); i++) {
+            const Statement* stmt = statements[i];
+            if (stmt->rank < 2 || (i >= first && i < freshEnd)) continue;
+
+            bool affected = stmt->rank == 3 && beginChanged;
+            for (size_t k = 0; k < stmt->names.size() && !affected; k++) {
+                affected = changedNames.count(stmt->names[k]) > 0;
+            }
+            if (affected) pending.push_back(i);
+        }
+    }
+
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+    size_t changedFrom = first;
+    for (auto index : pending) {
+        analyzeStatement(index);
+        changedFrom = std::min(changedFrom, index);
+    }
+
+    if (tableFullAt > first) {
+        if (lexemesChanged) rebuildLexerText();
+        else if (tableFullAt <= last) tableFullAt = freshEnd;
+        else tableFullAt = tableFullAt - last + freshEnd;
+    }
+
+    writeOutputs(changedFrom);
+    return true;
+}
+
+void IncrementalCompiler::rebuildLexerText() {
+    HashTable<Token> table(211);
+    tableFullAt = statements.size();
+
+    for (size_t i = 0; i < statements.size(); i++) {
+        for (const auto& token : statements[i]->tokens) {
+            table.insert(token.getLexeme(), token);
+        }
+        //        
+        if (table.getSize() == table.getCapacity()) {
+            tableFullAt = i + 1;
+            break;
+        }
+    }
+
+    std::ostringstream out;
+    table.printToStream(out);
+    lexerText = out.str();
+}
+
+//  ,    index
+const char* IncrementalCompiler::astPrefix(size_t index) const {
+    if (index == 0) return "Program\n";
+
+    int prev = statements[index - 1]->rank;
+    int cur = statements[index]->rank;
+    if (prev < 1) return cur >= 2 ? "  Descriptions\n  Operators\n" : "  Descriptions\n";
+    if (prev < 2 && cur >= 2) return "  Operators\n";
+    return "";
+}
+
+void IncrementalCompiler::writeOutputs(size_t from) {
+#ifdef _WIN32
+    //           
+    from = 0;
+#endif
+
+    std::ofstream lexerOutput(files.lexerOutFile);
+    lexerOutput << lexerText;
+    lexerOutput.close();
+
+    //    from    
+    size_t astOffset = 0;
+    size_t postfixOffset = 0;
+    if (from > 0) astOffset += std::strlen("Program\n");
+    if (from > 1) astOffset += std::strlen("  Descriptions\n");
+    if (from > 1 && statements[from - 1]->rank >= 2) astOffset += std::strlen("  Operators\n");
+    for (size_t i = 0; i < from; i++) {
+        astOffset += astBytes[i];
+        postfixOffset += postfixBytes[i];
+    }
+
+    std::string astTail;
+    std::string postfixTail;
+    for (size_t i = from; i < statements.size(); i++) {
+        astTail += astPrefix(i);
+        astTail += statements[i]->astText;
+        for (const auto& line : statements[i]->postfix) {
+            postfixTail += line;
+            postfixTail += "\n";
+        }
+    }
+    astTail += "Parsing completed successfully!\n";
+
+    //      :     
+    std::vector<std::string> postfix;
+    std::vector<int> postfixLines;
+    for (auto stmt : statements) {
+        postfix.insert(postfix.end(), stmt->postfix.begin(), stmt->postfix.end());
+        postfixLines.insert(postfixLines.end(), stmt->postfix.size(), stmt->firstLine);
+    }
+    Dataflow dataflow(postfix, postfixLines);
+    if (!dataflow.getWarnings().empty()) {
+        postfixTail += "\nWARNINGS:\n";
+        for (const auto& warning : dataflow.getWarnings()) {
+            postfixTail += warning;
+            postfixTail += "\n";
+        }
+    }
+
+    if (errorCount > 0) {
+        postfixTail += "\nERRORS:\n";
+        for (auto stmt : statements) {
+            for (const auto& error : stmt->errors) {
+                postfixTail += error;
+                postfixTail += "\n";
+            }
+        }
+        postfixTail += "\nSemantic analysis completed with " + std::to_string(errorCount) + " error(s)";
+    }
+    else {
+        postfixTail += "\nSemantic analysis completed successfully!";
+    }
+
+    // CALL  ,   compileFile;     
+    const Statement* begin = statements.empty() ? nullptr : statements[0];
+    bool named = begin && begin->tokens.size() > 1 && begin->tokens[1].getType() == TT_IDENTIFIER;
+    Linker linker;
+    linker.addUnit(named ? begin->tokens[1].getLexeme() : "", begin ? begin->firstLine : -1, postfix, postfixLines);
+    if (!linker.link()) {
+        postfixTail += "\n\nLINK ERRORS:\n";
+        for (const auto& error : linker.getErrors()) {
+            postfixTail += error;
+            postfixTail += "\n";
+        }
+        postfixTail += "\nLinking completed with " + std::to_string(linker.getErrors().size()) + " error(s)";
+    }
+
+    patchFile(files.parserOutFile, astOffset, astTail);
+    patchFile(files.semanticOutFile, postfixOffset, postfixTail);
+}
+
+void IncrementalCompiler::watch() {
+    update();
+
+    namespace fs = std::filesystem;
+    fs::path path(files.inFile);
+
+#ifdef __linux__
+    std::string dir = path.has_parent_path() ? path.parent_path().string() : ".";
+    std::string name = path.filename().string();
+
+    //  :      
+    int fd = inotify_init();
+    if (fd < 0 || inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "Cannot watch " << files.inFile << "\n";
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        bool changed = false;
+        for (char* p = buffer; p < buffer + length; ) {
+            auto event = reinterpret_cast<inotify_event*>(p);
+            if (event->len > 0 && name == event->name) changed = true;
+            p += sizeof(inotify_event) + event->len;
+        }
+        if (changed) update();
+    }
+    close(fd);
+#else
+    std::error_code ec;
+    auto lastWrite = fs::last_write_time(path, ec);
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        auto writeTime = fs::last_write_time(path, ec);
+        if (!ec && writeTime != lastWrite) {
+            lastWrite = writeTime;
+            update();
+        }
+    }
+#endif
+}
\ No newline at end of file
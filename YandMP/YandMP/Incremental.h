@@ -0,0 +1,74 @@
+#pragma once
+#include "Token.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "Compiler.h"
+#include "Cancel.h"
+#include <string>
+#include <vector>
+#include <sstream>
+
+//  (Begin, Descr, Op  End)     
+struct Statement {
+    int firstLine;                      //     
+    int lastLine;
+    int lineDelta;                      //       tokens  tree
+    int rank;                           //0 - Begin, 1 - Descr, 2 - Op, 3 - End
+    std::vector<Token> tokens;
+    Node* tree;
+    std::string astText;                //   
+    std::vector<std::string> postfix;   // 
+    std::vector<std::string> errors;    // 
+    std::vector<std::string> names;     //,   
+
+    Statement() : firstLine(0), lastLine(0), lineDelta(0), rank(0), tree(nullptr) {}
+};
+
+// :     
+//,        
+class IncrementalCompiler {
+public:
+    IncrementalCompiler(const CompileFiles& compileFiles);
+    ~IncrementalCompiler();
+
+    //   , 0 -  
+    void setDeadline(long long milliseconds);
+    //     .   
+    //   ,  
+    void update();
+    //    (inotify  Linux,      )
+    void watch();
+
+private:
+    CompileFiles files;
+    std::string text;                       //   
+    std::vector<size_t> lineStarts;         //    text
+    std::vector<Statement*> statements;
+    std::vector<size_t> astBytes;           //  ,  statements
+    std::vector<size_t> postfixBytes;
+    size_t errorCount;
+    bool valid;                             //   
+
+    SemanticAnalyzer* analyzer;
+    std::ostringstream analyzerOutput;
+
+    std::string lexerText;                  //  
+    size_t tableFullAt;                     // ,     
+    size_t recompiled;                      //    
+    long long deadline;                     //   , 0 - 
+    CancelToken cancel;
+
+    void fullRebuild(std::string& newText, std::vector<size_t>& newLineStarts);
+    bool updateStatements(std::string& newText, std::vector<size_t>& newLineStarts);
+    bool ordered(size_t from, size_t to) const;
+    bool buildStatements(const std::vector<Token>& tokenList, std::vector<Statement*>& result);
+    bool parseStatement(Statement& stmt);
+    void analyzeStatement(size_t index);
+    void resetAnalyzer();
+    void applyLineDelta(Statement& stmt);
+    void freeStatements(std::vector<Statement*>& list, size_t from, size_t to);
+
+    void rebuildLexerText();
+    void writeOutputs(size_t from);
+    const char* astPrefix(size_t index) const;
+};
\ No newline at end of file
@@ -0,0 +1,349 @@
+#include "Jit.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+//  x86-64
+enum {
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15
+};
+const int XMM15 = 15;
+
+//    ; r11  xmm15 - , rbx/rbp/r12  .
+// d   INT_REGS[d]  xmm<d>,   JIT_REGS -  
+const int INT_REGS[] = { RAX, RCX, RDX, RSI, RDI, R8, R9, R10 };
+const int JIT_REGS = sizeof(INT_REGS) / sizeof(INT_REGS[0]);
+
+void JitCompiler::byte(uint8_t b) {
+    buffer.push_back(b);
+}
+
+void JitCompiler::imm32(uint32_t value) {
+    for (int k = 0; k < 4; k++) byte((uint8_t)(value >> (8 * k)));
+}
+
+void JitCompiler::imm64(uint64_t value) {
+    for (int k = 0; k < 8; k++) byte((uint8_t)(value >> (8 * k)));
+}
+
+// REX   64-    r8-r15/xmm8-xmm15
+void JitCompiler::rex(bool wide, int reg, int rm) {
+    uint8_t b = 0x40 | (wide ? 8 : 0) | ((reg >> 3) & 1) << 2 | ((rm >> 3) & 1);
+    if (b != 0x40) byte(b);
+}
+
+void JitCompiler::modrmReg(int reg, int rm) {
+    byte((uint8_t)(0xC0 | (reg & 7) << 3 | (rm & 7)));
+}
+
+// [base + disp32]; base    rsp/r12 (   SIB)
+void JitCompiler::modrmMem(int reg, int base, int32_t disp) {
+    byte((uint8_t)(0x80 | (reg & 7) << 3 | (base & 7)));
+    imm32((uint32_t)disp);
+}
+
+void JitCompiler::push(int reg) {
+    rex(false, 0, reg);
+    byte((uint8_t)(0x50 + (reg & 7)));
+}
+
+void JitCompiler::pop(int reg) {
+    rex(false, 0, reg);
+    byte((uint8_t)(0x58 + (reg & 7)));
+}
+
+void JitCompiler::movImm(int reg, long long value) {
+    rex(true, 0, reg);
+    if (value >= INT32_MIN && value <= INT32_MAX) {
+        byte(0xC7);
+        modrmReg(0, reg);
+        imm32((uint32_t)value);
+    }
+    else {
+        byte((uint8_t)(0xB8 + (reg & 7)));
+        imm64((uint64_t)value);
+    }
+}
+
+void JitCompiler::movReg(int dst, int src) {
+    rex(true, src, dst);
+    byte(0x89);
+    modrmReg(src, dst);
+}
+
+void JitCompiler::movLoad(int reg, int base, int32_t disp) {
+    rex(true, reg, base);
+    byte(0x8B);
+    modrmMem(reg, base, disp);
+}
+
+void JitCompiler::movStore(int base, int32_t disp, int reg) {
+    rex(true, reg, base);
+    byte(0x89);
+    modrmMem(reg, base, disp);
+}
+
+void JitCompiler::alu(uint8_t opcode, int dst, int src) {
+    rex(true, src, dst);
+    byte(opcode);
+    modrmReg(src, dst);
+}
+
+void JitCompiler::aluMem(uint8_t opcode, int base, int32_t disp, int src) {
+    rex(true, src, base);
+    byte(opcode);
+    modrmMem(src, base, disp);
+}
+
+void JitCompiler::sse(uint8_t prefix, uint8_t opcode, bool wide, int reg, int rm) {
+    byte(prefix);
+    rex(wide, reg, rm);
+    byte(0x0F);
+    byte(opcode);
+    modrmReg(reg, rm);
+}
+
+void JitCompiler::sseMem(uint8_t prefix, uint8_t opcode, bool wide, int reg, int base, int32_t disp) {
+    byte(prefix);
+    rex(wide, reg, base);
+    byte(0x0F);
+    byte(opcode);
+    modrmMem(reg, base, disp);
+}
+
+void JitCompiler::callAbsolute(const void* target) {
+    movImm(R11, (long long)(uintptr_t)target);
+    rex(false, 0, R11);
+    byte(0xFF);
+    modrmReg(2, R11);
+}
+
+bool JitCompiler::inReg(int d) const {
+    return d < JIT_REGS;
+}
+
+//cvtsi2sd    d
+void JitCompiler::toReal(int d) {
+    if (inReg(d)) {
+        sse(0xF2, 0x2A, true, d, INT_REGS[d]);
+    }
+    else {
+        sseMem(0xF2, 0x2A, true, XMM15, RBP, spill(d));
+        sseMem(0xF2, 0x11, false, XMM15, RBP, spill(d));
+    }
+}
+
+//    CALL Print
+static void jitPrint(JitRuntime* rt, uint32_t types, uint32_t count) {
+    rt->vm->callPrint(rt->args, types, count, *rt->out);
+}
+
+bool JitCompiler::compile(VirtualMachine& machine) {
+    release();
+    error.clear();
+    vm = &machine;
+
+#ifndef JIT_SUPPORTED
+    error = "JIT is not supported on this platform";
+    return false;
+#else
+    const auto& slotTypes = machine.getSlotTypes();
+    //     
+    for (uint32_t length : machine.getSlotLengths()) {
+        if (length > 0) {
+            error = "Arrays are not supported by JIT";
+            return false;
+        }
+    }
+    std::vector<TokenType> types;       //  
+    spillBase = (int)machine.getMaxStack() + 1;
+    buffer.clear();
+
+    //: rbx - , rbp -  Print   , r12 - JitRuntime.
+    //  push    16   
+    push(RBX);
+    push(RBP);
+    push(R12);
+    movReg(RBX, RDI);
+    movReg(RBP, RSI);
+    movReg(R12, RDX);
+
+    for (const auto& instr : machine.getCode()) {
+        int d = (int)types.size() - 1;     //   
+        int32_t var = (int32_t)instr.arg * 8;
+
+        switch (instr.op) {
+        case VM_PUSH_I:
+            if (inReg(d + 1)) {
+                movImm(INT_REGS[d + 1], instr.imm.i);
+            }
+            else {
+                movImm(R11, instr.imm.i);
+                movStore(RBP, spill(d + 1), R11);
+            }
+            types.push_back(TT_INTEGER);
+            break;
+        case VM_PUSH_R: {
+            long long bits;
+            std::memcpy(&bits, &instr.imm.r, sizeof(bits));
+            movImm(R11, bits);
+            if (inReg(d + 1)) sse(0x66, 0x6E, true, d + 1, R11);       //movq xmm, r11
+            else movStore(RBP, spill(d + 1), R11);
+            types.push_back(TT_REAL);
+            break;
+        }
+        case VM_LOAD:
+            if (!inReg(d + 1)) {
+                movLoad(R11, RBX, var);
+                movStore(RBP, spill(d + 1), R11);
+            }
+            else if (slotTypes[instr.arg] == TT_REAL) {
+                sseMem(0xF2, 0x10, false, d + 1, RBX, var);            //movsd
+            }
+            else {
+                movLoad(INT_REGS[d + 1], RBX, var);
+            }
+            types.push_back(slotTypes[instr.arg]);
+            break;
+        case VM_STORE:
+            if (!inReg(d)) {
+                movLoad(R11, RBP, spill(d));
+                movStore(RBX, var, R11);
+            }
+            else if (types[d] == TT_REAL) {
+                sseMem(0xF2, 0x11, false, d, RBX, var);
+            }
+            else {
+                movStore(RBX, var, INT_REGS[d]);
+            }
+            types.pop_back();
+            break;
+        case VM_ADD_I:
+        case VM_SUB_I: {
+            uint8_t opcode = instr.op == VM_ADD_I ? 0x01 : 0x29;
+            if (inReg(d)) {
+                alu(opcode, INT_REGS[d - 1], INT_REGS[d]);
+            }
+            else {
+                movLoad(R11, RBP, spill(d));
+                if (inReg(d - 1)) alu(opcode, INT_REGS[d - 1], R11);
+                else aluMem(opcode, RBP, spill(d - 1), R11);
+            }
+            types.pop_back();
+            break;
+        }
+        case VM_ADD_R:
+        case VM_SUB_R: {
+            uint8_t opcode = instr.op == VM_ADD_R ? 0x58 : 0x5C;      //addsd, subsd
+            if (inReg(d)) {
+                sse(0xF2, opcode, false, d - 1, d);
+            }
+            else if (inReg(d - 1)) {
+                sseMem(0xF2, opcode, false, d - 1, RBP, spill(d));
+            }
+            else {
+                sseMem(0xF2, 0x10, false, XMM15, RBP, spill(d - 1));
+                sseMem(0xF2, opcode, false, XMM15, RBP, spill(d));
+                sseMem(0xF2, 0x11, false, XMM15, RBP, spill(d - 1));
+            }
+            types.pop_back();
+            break;
+        }
+        case VM_I2R:
+            toReal(d);
+            types[d] = TT_REAL;
+            break;
+        case VM_I2R_NEXT:
+            toReal(d - 1);
+            types[d - 1] = TT_REAL;
+            break;
+        case VM_R2I:
+            if (inReg(d)) {
+                sse(0xF2, 0x2C, true, INT_REGS[d], d);                  //cvttsd2si
+            }
+            else {
+                sseMem(0xF2, 0x2C, true, R11, RBP, spill(d));
+                movStore(RBP, spill(d), R11);
+            }
+            types[d] = TT_INTEGER;
+            break;
+        case VM_PRINT: {
+            //   JitRuntime::args,      
+            int first = d + 1 - (int)instr.arg;
+            for (int k = 0; k < (int)instr.arg; k++) {
+                int p = first + k;
+                if (!inReg(p)) {
+                    movLoad(R11, RBP, spill(p));
+                    movStore(RBP, k * 8, R11);
+                }
+                else if (types[p] == TT_REAL) {
+                    sseMem(0xF2, 0x11, false, p, RBP, k * 8);
+                }
+                else {
+                    movStore(RBP, k * 8, INT_REGS[p]);
+                }
+            }
+            types.resize(first);
+            movReg(RDI, R12);
+            movImm(RSI, instr.imm.i);
+            movImm(RDX, instr.arg);
+            callAbsolute((const void*)&jitPrint);
+            break;
+        }
+        case VM_HALT:
+            break;
+        default:
+            error = "Unsupported instruction";
+            return false;
+        }
+    }
+
+    //
+    pop(R12);
+    pop(RBP);
+    pop(RBX);
+    byte(0xC3);
+
+    void* memory = mmap(nullptr, buffer.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        error = "Cannot allocate executable memory";
+        return false;
+    }
+    std::memcpy(memory, buffer.data(), buffer.size());
+    if (mprotect(memory, buffer.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, buffer.size());
+        error = "Cannot make JIT code executable";
+        return false;
+    }
+    code = memory;
+    codeSize = buffer.size();
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    slots.assign(slotTypes.size(), VmValue{ 0 });
+    args.assign(2 * spillBase, VmValue{ 0 });
+    return true;
+#endif
+}
+
+void JitCompiler::run(std::ostream& out) {
+    if (!code) return;
+    std::fill(slots.begin(), slots.end(), VmValue{ 0 });
+
+    JitRuntime rt{ vm, &out, args.data() };
+    typedef void (*Entry)(VmValue* vars, VmValue* args, JitRuntime* rt);
+    ((Entry)code)(slots.data(), args.data(), &rt);
+    vm->flush(out);
+}
+
+void JitCompiler::release() {
+#ifdef JIT_SUPPORTED
+    if (code) munmap(code, codeSize);
+#endif
+    code = nullptr;
+    codeSize = 0;
+}
\ No newline at end of file
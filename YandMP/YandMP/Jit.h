@@ -0,0 +1,78 @@
+#pragma once
+#include "VirtualMachine.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//     Linux x86-64 (System V ABI),
+//      
+#if defined(__linux__) && defined(__x86_64__)
+#define JIT_SUPPORTED
+#endif
+
+//  ,      r12
+struct JitRuntime {
+    VirtualMachine* vm;
+    std::ostream* out;
+    VmValue* args;          //   Print
+};
+
+//JIT-:       x86-64.
+//      (INTEGER -   
+//, REAL -   SSE2),     
+//   Print;       rbx,
+//Print     
+class JitCompiler {
+public:
+    JitCompiler() : vm(nullptr), code(nullptr), codeSize(0), spillBase(0) {}
+    ~JitCompiler() { release(); }
+
+    JitCompiler(const JitCompiler&) = delete;
+    JitCompiler& operator=(const JitCompiler&) = delete;
+
+    //  ; false -    
+    bool compile(VirtualMachine& machine);
+    const std::string& getError() const { return error; }
+
+    void run(std::ostream& out);
+
+    size_t getCodeSize() const { return codeSize; }
+    const std::vector<VmValue>& getSlots() const { return slots; }
+
+private:
+    VirtualMachine* vm;
+    void* code;
+    size_t codeSize;
+    std::vector<uint8_t> buffer;
+    std::vector<VmValue> slots;
+    std::vector<VmValue> args;      // Print,    
+    int spillBase;
+    std::string error;
+
+    void release();
+
+    //  x86-64
+    void byte(uint8_t b);
+    void imm32(uint32_t value);
+    void imm64(uint64_t value);
+    void rex(bool wide, int reg, int rm);
+    void modrmReg(int reg, int rm);
+    void modrmMem(int reg, int base, int32_t disp);
+    void push(int reg);
+    void pop(int reg);
+    void movImm(int reg, long long value);
+    void movReg(int dst, int src);
+    void movLoad(int reg, int base, int32_t disp);
+    void movStore(int base, int32_t disp, int reg);
+    void alu(uint8_t opcode, int dst, int src);
+    void aluMem(uint8_t opcode, int base, int32_t disp, int src);
+    void sse(uint8_t prefix, uint8_t opcode, bool wide, int reg, int rm);
+    void sseMem(uint8_t prefix, uint8_t opcode, bool wide, int reg, int base, int32_t disp);
+    void callAbsolute(const void* target);
+
+    //  d:        [rbp + spill(d)]
+    bool inReg(int d) const;
+    int32_t spill(int d) const { return (spillBase + d) * 8; }
+    void toReal(int d);
+};
\ No newline at end of file
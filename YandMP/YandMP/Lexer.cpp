@@ -1,10 +1,33 @@
 #include "Lexer.h"
+#include "Trace.h"
 #include <cctype>
+#include <cfloat>
+#include <charconv>
 #include <vector>
 #include <algorithm>
 
 Lexer::Lexer(const std::string& inFile, const std::string& outFile)
-    : fin(inFile), fout(outFile), table(211), currentLine(1) {
+    : finFile(inFile), fin(finFile), foutFile(outFile), fout(foutFile), table(211), currentLine(1), offset(0), lineStarts(1, 0) {
+}
+
+Lexer::Lexer(const std::string& inFile, std::ostream& output)
+    : finFile(inFile), fin(finFile), fout(output), table(211), currentLine(1), offset(0), lineStarts(1, 0) {
+}
+
+Lexer::Lexer(const std::string& text, int firstLine)
+    : finText(text), fin(finText), fout(foutFile), table(211), currentLine(firstLine), offset(0), lineStarts(1, 0) {
+}
+
+std::vector<Token> Lexer::tokenize(const std::string& text, int firstLine) {
+    Lexer lexer(text, firstLine);
+    std::vector<Token> result;
+
+    while (lexer.fin && lexer.fin.peek() != EOF) {
+        Token tok = lexer.nextToken();
+        if (tok.getLexeme().empty() && tok.getType() == TT_UNKNOWN) break;
+        result.push_back(tok);
+    }
+    return result;
 }
 
 int Lexer::peekChar() {
@@ -13,14 +36,22 @@ int Lexer::peekChar() {
 
 int Lexer::getChar() {
     int c = fin.get();
+    if (c == EOF) return c;
+    offset++;
     if (c == '\n') {
         currentLine++;
+        lineStarts.push_back(offset);
     }
     return c;
 }
 
 void Lexer::ungetChar() {
     fin.unget();
+    offset--;
+    if (lineStarts.back() > offset) {
+        lineStarts.pop_back();
+        currentLine--;
+    }
 }
 
 void Lexer::skipWhitespace() {
@@ -33,8 +64,61 @@ bool Lexer::isKeyword(const std::string& s) const {
     return false;
 }
 
+//        
+static size_t significantDigits(const std::string& num) {
+    std::string digits;
+    for (char c : num) if (c != '.') digits.push_back(c);
+    size_t first = digits.find_first_not_of('0');
+    if (first == std::string::npos) return 0;
+    return digits.find_last_not_of('0') - first + 1;
+}
+
+//    , .   
+//  REAL -  
+Token Lexer::decodeNumber(const std::string& num, TokenType type, int line) {
+    Token tok(num, type, line);
+    if (type == TT_ERROR) return tok;
+
+    const char* first = num.data();
+    const char* last = first + num.size();
+    if (type == TT_INTEGER) {
+        long long value = 0;
+        if (std::from_chars(first, last, value).ec != std::errc()) {
+            errorReason = "integer constant out of range";
+            tok.setType(TT_ERROR);
+            return tok;
+        }
+        tok.setIntValue(value);
+    }
+    else {
+        double value = 0;
+        if (significantDigits(num) > DBL_DECIMAL_DIG) {
+            errorReason = "real constant has more than " + std::to_string(DBL_DECIMAL_DIG) + " significant digits";
+            tok.setType(TT_ERROR);
+            return tok;
+        }
+        if (std::from_chars(first, last, value).ec != std::errc()) {
+            errorReason = "real constant out of range";
+            tok.setType(TT_ERROR);
+            return tok;
+        }
+        tok.setRealValue(value);
+    }
+    constants.add(num, type, tok.getIntValue(), tok.getRealValue());
+    return tok;
+}
+
+//     ,       
 Token Lexer::nextToken() {
+    errorReason.clear();
     skipWhitespace();
+    size_t start = offset;
+    Token tok = scanToken();
+    tok.setPosition(start, (int)(start - lineStarts.back()) + 1);
+    return tok;
+}
+
+Token Lexer::scanToken() {
     if (!fin) return Token("", TT_UNKNOWN, currentLine);
 
     int c = peekChar();
@@ -87,10 +171,10 @@ Token Lexer::nextToken() {
                     num.push_back((char)getChar());
                 }
             }
-            return Token(num, hasError ? TT_ERROR : TT_REAL, startLine);
+            return decodeNumber(num, hasError ? TT_ERROR : TT_REAL, startLine);
         }
         else {
-            return Token(num, hasError ? TT_ERROR : TT_INTEGER, startLine);
+            return decodeNumber(num, hasError ? TT_ERROR : TT_INTEGER, startLine);
         }
     }
 
@@ -111,28 +195,34 @@ Token Lexer::nextToken() {
 }
 
 void Lexer::run() {
-    if (!fin.is_open()) {
+    TraceSpan span("Lexer::run");
+    if (!finFile.is_open()) {
         std::cerr << "Cannot open input file\n";
         return;
     }
-    if (!fout.is_open()) {
+    if (!fout) {
         std::cerr << "Cannot open output file\n";
         return;
     }
 
     tokens.clear();
     currentLine = 1;
+    offset = 0;
+    lineStarts.assign(1, 0);
 
     while (fin && fin.peek() != EOF) {
+        if (cancelPoll.poll()) return;
         Token tok = nextToken();
         if (tok.getLexeme().empty() && tok.getType() == TT_UNKNOWN) break;
 
         tokens.push_back(tok);
 
         if (tok.getType() == TT_ERROR) {
-            fout << "LEXICAL ERROR: " << tok.getLexeme() << "\n";
+            fout << "LEXICAL ERROR: " << tok.getLexeme();
+            if (!errorReason.empty()) fout << " (" << errorReason << ")";
+            fout << "\n";
         }
-        int idx = table.insert(tok.getLexeme(), tok);
+        table.insert(tok.getLexeme(), tok);
     }
     table.printToStream(fout);
 }
\ No newline at end of file
@@ -1,27 +1,54 @@
 #pragma once
 #include "Token.h"
 #include "HashTable.h"
+#include "ConstantPool.h"
+#include "Cancel.h"
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
 class Lexer {
 public:
     Lexer(const std::string& inFile, const std::string& outFile);
+    Lexer(const std::string& inFile, std::ostream& output);
     void run();
+
+    // ,      ; getTokens() -   
+    void setCancel(const CancelToken* token) { cancelPoll.setToken(token); }
+    bool isCancelled() const { return cancelPoll.isStopped(); }
     std::vector<Token> getTokens() const { return tokens; }
+    const ConstantPool& getConstants() const { return constants; }
+
+    //  :  n    getLineStarts()[n - 1]
+    const std::vector<size_t>& getLineStarts() const { return lineStarts; }
+
+    //   ,    firstLine
+    static std::vector<Token> tokenize(const std::string& text, int firstLine = 1);
 
 private:
-    std::ifstream fin;
-    std::ofstream fout;
+    Lexer(const std::string& text, int firstLine);
+
+    std::ifstream finFile;
+    std::istringstream finText;
+    std::istream& fin;
+    std::ofstream foutFile;
+    std::ostream& fout;
     HashTable<Token> table;
     std::vector<Token> tokens;
+    ConstantPool constants;     //  
+    std::string errorReason;    //    
     int currentLine;
+    size_t offset;                  //  
+    std::vector<size_t> lineStarts;
+    CancelPoll cancelPoll;
 
     int peekChar();
     int getChar();
     void ungetChar();
     void skipWhitespace();
     Token nextToken();
+    Token scanToken();
+    Token decodeNumber(const std::string& num, TokenType type, int line);
     bool isKeyword(const std::string& s) const;
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Linker.h"
+#include "ObjectCode.h"
+#include "Trace.h"
+#include <cstdlib>
+#include <iterator>
+
+//      
+static const LinkSymbol builtins[] = {
+    LinkSymbol("Print", -1, -1, -1)
+};
+
+void Linker::addUnit(const std::string& name, int line, const std::vector<std::string>& postfix,
+    const std::vector<int>& postfixLines) {
+    units.push_back(Unit{ name, line, &postfix, &postfixLines });
+}
+
+void Linker::error(int line, const std::string& message) {
+    if (stopped) return;
+    if (budget && !budget->reserve()) {
+        stopped = true;
+        return;
+    }
+    errors.push_back("LINK ERROR at line " + std::to_string(line) + ": " + message);
+}
+
+bool Linker::link() {
+    TraceSpan span("Linker::link");
+    errors.clear();
+    stopped = false;
+    calls.assign(units.size(), std::vector<Call>());
+    resolvedCalls = 0;
+
+    //    :      
+    HashTable<LinkSymbol> symbols((int)(2 * (units.size() + std::size(builtins))) + 1);
+    for (const auto& builtin : builtins) {
+        symbols.insert(builtin.name, builtin);
+    }
+    for (size_t u = 0; u < units.size(); u++) {
+        const Unit& unit = units[u];
+        //      
+        if (unit.name.empty()) continue;
+
+        const LinkSymbol* defined = symbols.getValue(symbols.findIndex(unit.name));
+        if (defined && defined->unit < 0) {
+            error(unit.line, "Program '" + unit.name + "' has the name of a builtin procedure");
+        }
+        else if (defined) {
+            error(unit.line, "Program '" + unit.name + "' is already defined at line " + std::to_string(defined->line));
+        }
+        else {
+            symbols.insert(unit.name, LinkSymbol(unit.name, (int)u, 0, unit.line));
+        }
+    }
+
+    // ... N CALL; N   
+    for (size_t u = 0; u < units.size(); u++) {
+        const std::vector<std::string>& postfix = *units[u].postfix;
+        for (size_t n = 0; n < postfix.size(); n++) {
+            std::vector<std::string> items = splitPostfix(postfix[n]);
+            if (items.size() < 3 || items.back() != "CALL") continue;
+
+            int line = n < units[u].postfixLines->size() ? (*units[u].postfixLines)[n] : -1;
+            const std::string& name = items[0];
+            int arguments = std::atoi(items[items.size() - 2].c_str()) - 1;
+
+            const LinkSymbol* target = symbols.getValue(symbols.findIndex(name));
+            if (!target) {
+                error(line, "Unknown procedure '" + name + "'");
+                continue;
+            }
+            if (target->arity >= 0 && target->arity != arguments) {
+                error(line, "Procedure '" + name + "' expects " + std::to_string(target->arity) +
+                    " argument(s), got " + std::to_string(arguments));
+                continue;
+            }
+            if (target->unit >= 0) calls[u].push_back(Call{ target->unit, line });
+            resolvedCalls++;
+        }
+    }
+
+    findRecursion();
+    return errors.empty() && !stopped;
+}
+
+//         :   
+//,    ,  
+void Linker::findRecursion() {
+    enum State { UNVISITED, ON_PATH, DONE };
+    std::vector<State> state(units.size(), UNVISITED);
+    struct Frame {
+        int unit;
+        size_t next;
+    };
+
+    for (size_t root = 0; root < units.size(); root++) {
+        if (state[root] != UNVISITED) continue;
+        std::vector<Frame> path(1, Frame{ (int)root, 0 });
+        state[root] = ON_PATH;
+
+        while (!path.empty()) {
+            Frame& frame = path.back();
+            if (frame.next == calls[frame.unit].size()) {
+                state[frame.unit] = DONE;
+                path.pop_back();
+                continue;
+            }
+            const Call& call = calls[frame.unit][frame.next++];
+            if (state[call.callee] == ON_PATH) {
+                error(call.line, "Recursive call of program '" + units[call.callee].name + "'");
+            }
+            else if (state[call.callee] == UNVISITED) {
+                state[call.callee] = ON_PATH;
+                path.push_back(Frame{ call.callee, 0 });
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "HashTable.h"
+#include "Diagnostic.h"
+#include <string>
+#include <vector>
+
+//   :      
+struct LinkSymbol {
+    std::string name;
+    int unit;           // , -1 - 
+    int arity;          // , -1 - 
+    int line;           // PROGRAM 
+
+    LinkSymbol() : name(""), unit(-1), arity(-1), line(-1) {}
+    LinkSymbol(const std::string& n, int u, int a, int l) : name(n), unit(u), arity(a), line(l) {}
+
+    std::string getKey() const { return name; }
+};
+
+//     PROGRAM ... END.  
+//,  CALL    ;   CALL    
+//       .  
+// ,        CALL,  
+//  ,    ,  
+class Linker {
+public:
+    //    ; postfix  postfixLines -   
+    void addUnit(const std::string& name, int line, const std::vector<std::string>& postfix,
+        const std::vector<int>& postfixLines);
+
+    //       ;    
+    void setErrorBudget(ErrorBudget* errorBudget) { budget = errorBudget; }
+
+    //false -   
+    bool link();
+    bool isStopped() const { return stopped; }
+
+    const std::vector<std::string>& getErrors() const { return errors; }
+    size_t getResolvedCalls() const { return resolvedCalls; }
+
+private:
+    struct Unit {
+        std::string name;
+        int line;
+        const std::vector<std::string>* postfix;
+        const std::vector<int>* postfixLines;
+    };
+
+    //  :     CALL
+    struct Call {
+        int callee;
+        int line;
+    };
+
+    std::vector<Unit> units;
+    std::vector<std::vector<Call>> calls;
+    std::vector<std::string> errors;
+    size_t resolvedCalls = 0;
+    ErrorBudget* budget = nullptr;
+    bool stopped = false;               //  ,    
+
+    void error(int line, const std::string& message);
+    void findRecursion();
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "Memory.h"
+#include <atomic>
+#include <cstdlib>
+
+#ifdef MEMORY_TRACKING
+#include <malloc.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+// ;      ,
+//  operator new      main
+static std::atomic<bool> tracking(false);
+static std::atomic<bool> budgetExceeded(false);
+static std::atomic<size_t> budget(0);
+static std::atomic<size_t> liveBytes(0);
+static std::atomic<size_t> peakBytes(0);
+static std::atomic<int> currentPhase(-1);
+
+static std::atomic<size_t> phaseAllocations[MemoryTracker::MAX_PHASES];
+static std::atomic<size_t> phaseBytes[MemoryTracker::MAX_PHASES];
+static std::atomic<size_t> phasePeak[MemoryTracker::MAX_PHASES];
+
+static void raiseTo(std::atomic<size_t>& value, size_t candidate) {
+    size_t current = value.load(std::memory_order_relaxed);
+    while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+    }
+}
+
+#ifdef MEMORY_TRACKING
+static size_t blockSize(void* block) {
+#ifdef _WIN32
+    return _msize(block);
+#else
+    return malloc_usable_size(block);
+#endif
+}
+
+static void trackAllocation(void* block) {
+    size_t size = blockSize(block);
+    size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    //   :      
+    size_t limit = budget.load(std::memory_order_relaxed);
+    if (limit > 0 && live > limit && !budgetExceeded.exchange(true)) {
+        liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        std::free(block);
+        throw MemoryBudgetExceeded();
+    }
+
+    raiseTo(peakBytes, live);
+
+    int phase = currentPhase.load(std::memory_order_relaxed);
+    if (phase >= 0) {
+        phaseAllocations[phase].fetch_add(1, std::memory_order_relaxed);
+        phaseBytes[phase].fetch_add(size, std::memory_order_relaxed);
+        raiseTo(phasePeak[phase], live);
+    }
+}
+
+static void trackFree(void* block) {
+    //,    ,      
+    size_t size = blockSize(block);
+    size_t live = liveBytes.load(std::memory_order_relaxed);
+    while (!liveBytes.compare_exchange_weak(live, live > size ? live - size : 0, std::memory_order_relaxed)) {
+    }
+}
+#endif
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+#ifdef MEMORY_TRACKING
+    if (tracking.load(std::memory_order_relaxed)) trackAllocation(block);
+#endif
+    return block;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept {
+    if (!block) return;
+#ifdef MEMORY_TRACKING
+    if (tracking.load(std::memory_order_relaxed)) trackFree(block);
+#endif
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    operator delete(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+void MemoryTracker::enable(size_t limit) {
+    budget = limit;
+    tracking = isSupported();
+}
+
+bool MemoryTracker::isEnabled() {
+    return tracking;
+}
+
+bool MemoryTracker::isSupported() {
+#ifdef MEMORY_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MemoryTracker::beginPhase(int phase) {
+    if (phase < 0 || phase >= MAX_PHASES) return;
+    raiseTo(phasePeak[phase], liveBytes.load());
+    currentPhase = phase;
+}
+
+void MemoryTracker::endPhase() {
+    currentPhase = -1;
+}
+
+MemoryTracker::PhaseMemory MemoryTracker::getPhase(int phase) {
+    if (phase < 0 || phase >= MAX_PHASES) return PhaseMemory{ 0, 0, 0 };
+    return PhaseMemory{ phaseAllocations[phase].load(), phaseBytes[phase].load(), phasePeak[phase].load() };
+}
+
+size_t MemoryTracker::getLiveBytes() {
+    return liveBytes;
+}
+
+size_t MemoryTracker::getPeakBytes() {
+    return peakBytes;
+}
+
+size_t MemoryTracker::getBudget() {
+    return budget;
+}
+
+size_t MemoryTracker::getPeakRss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.PeakWorkingSetSize;
+    return 0;
+#elif defined(__unix__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return (size_t)usage.ru_maxrss * 1024;      // Linux - 
+#else
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+//      (_msize, malloc_usable_size),
+//      
+#if defined(_WIN32) || defined(__linux__)
+#define MEMORY_TRACKING
+#endif
+
+//   
+class MemoryBudgetExceeded : public std::bad_alloc {
+public:
+    const char* what() const noexcept override { return "memory budget exceeded"; }
+};
+
+//      operator new / delete.
+//   ,    malloc  free
+class MemoryTracker {
+public:
+    //   (  - CompileStats::Phase)
+    struct PhaseMemory {
+        size_t allocations;
+        size_t bytes;           // 
+        size_t peak;            //      
+    };
+
+    static const int MAX_PHASES = 8;
+
+    //budget -     , 0 -  
+    static void enable(size_t budget = 0);
+    static bool isEnabled();
+    static bool isSupported();
+
+    static void beginPhase(int phase);
+    static void endPhase();
+
+    static PhaseMemory getPhase(int phase);
+    static size_t getLiveBytes();
+    static size_t getPeakBytes();
+    static size_t getBudget();
+
+    //       , 0 - 
+    static size_t getPeakRss();
+};
\ No newline at end of file
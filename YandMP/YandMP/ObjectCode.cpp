@@ -0,0 +1,326 @@
+#include "ObjectCode.h"
+#include "Trace.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+std::vector<std::string> splitPostfix(const std::string& line) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    for (;;) {
+        size_t pos = line.find(' ', start);
+        if (pos == std::string::npos) {
+            items.push_back(line.substr(start));
+            return items;
+        }
+        items.push_back(line.substr(start, pos - start));
+        start = pos + 1;
+    }
+}
+
+int postfixArity(const std::string& item) {
+    if (item == "+" || item == "-" || item == "ADD_I" || item == "ADD_R" || item == "SUB_I" || item == "SUB_R" ||
+        item == "VADD_I" || item == "VADD_R" || item == "VSUB_I" || item == "VSUB_R") {
+        return 2;
+    }
+    return item == "I2R" ? 1 : 0;
+}
+
+// : ,     
+static bool isConstant(const std::string& item) {
+    size_t start = item.size() > 1 && item[0] == '-' ? 1 : 0;
+    return !item.empty() && std::isdigit((unsigned char)item[start]);
+}
+
+void ObjectCode::clear() {
+    code.clear();
+    constants.clear();
+    symbols.clear();
+    lines.clear();
+    constIndex.clear();
+    symbolIndex.clear();
+}
+
+uint32_t ObjectCode::addConst(const std::string& text) {
+    auto it = constIndex.find(text);
+    if (it != constIndex.end()) return it->second;
+
+    Constant c;
+    const ConstantPool::Value* value = pool ? pool->find(text) : nullptr;
+    if (value) {
+        c.type = value->type;
+        c.intValue = value->intValue;
+        c.realValue = value->type == TT_REAL ? value->realValue : (double)value->intValue;
+    }
+    else {
+        c.type = text.find_first_of(".eE") != std::string::npos ? TT_REAL : TT_INTEGER;
+        c.intValue = c.type == TT_INTEGER ? std::strtoll(text.c_str(), nullptr, 10) : 0;
+        c.realValue = std::strtod(text.c_str(), nullptr);
+    }
+    c.text = text;
+
+    uint32_t index = (uint32_t)constants.size();
+    constants.push_back(c);
+    constIndex.emplace(text, index);
+    return index;
+}
+
+uint32_t ObjectCode::addSymbol(const std::string& name, SymbolKind kind, TokenType type) {
+    auto key = std::make_pair(name, (int)kind);
+    auto it = symbolIndex.find(key);
+    if (it != symbolIndex.end()) {
+        if (symbols[it->second].type == TT_UNKNOWN) symbols[it->second].type = type;
+        return it->second;
+    }
+
+    uint32_t index = (uint32_t)symbols.size();
+    symbols.push_back(Symbol{ name, kind, type });
+    symbolIndex.emplace(key, index);
+    return index;
+}
+
+void ObjectCode::addExpression(const std::vector<std::string>& items, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        const std::string& item = items[i];
+        if (item == "+") code.push_back(Instr{ OP_ADD, 0 });
+        else if (item == "-") code.push_back(Instr{ OP_SUB, 0 });
+        else if (item == "ADD_I") code.push_back(Instr{ OP_ADD_I, 0 });
+        else if (item == "ADD_R") code.push_back(Instr{ OP_ADD_R, 0 });
+        else if (item == "SUB_I") code.push_back(Instr{ OP_SUB_I, 0 });
+        else if (item == "SUB_R") code.push_back(Instr{ OP_SUB_R, 0 });
+        else if (item == "VADD_I") code.push_back(Instr{ OP_VADD_I, 0 });
+        else if (item == "VADD_R") code.push_back(Instr{ OP_VADD_R, 0 });
+        else if (item == "VSUB_I") code.push_back(Instr{ OP_VSUB_I, 0 });
+        else if (item == "VSUB_R") code.push_back(Instr{ OP_VSUB_R, 0 });
+        else if (item == "I2R") code.push_back(Instr{ OP_I2R, 0 });
+        else if (isConstant(item)) code.push_back(Instr{ OP_CONST, addConst(item) });
+        else code.push_back(Instr{ OP_SYMBOL, addSymbol(item, SYM_VARIABLE) });
+    }
+}
+
+//      ,     
+void ObjectCode::build(const std::vector<std::string>& postfix, const std::vector<int>& postfixLines,
+    const ConstantPool* constants) {
+    clear();
+    pool = constants;
+
+    for (size_t n = 0; n < postfix.size(); n++) {
+        std::vector<std::string> items = splitPostfix(postfix[n]);
+        const std::string& last = items.back();
+        size_t count = items.size();
+
+        lines.push_back(LineEntry{ (uint32_t)code.size(), n < postfixLines.size() ? postfixLines[n] : -1 });
+
+        if (last == "PROGRAM" || last == "END") {
+            // PROGRAM |  END
+            code.push_back(Instr{ OP_SYMBOL, addSymbol(items[0], SYM_PROGRAM) });
+            code.push_back(Instr{ last == "PROGRAM" ? OP_PROGRAM : OP_END, 0 });
+        }
+        else if (last == "DECL") {
+            //  ... N DECL
+            TokenType type = items[0] == "INTEGER" ? TT_INTEGER : TT_REAL;
+            code.push_back(Instr{ OP_TYPE, (uint32_t)type });
+            for (size_t i = 1; i + 2 < count; i++) {
+                code.push_back(Instr{ OP_SYMBOL, addSymbol(items[i], SYM_VARIABLE, type) });
+            }
+            code.push_back(Instr{ OP_COUNT, (uint32_t)std::strtoul(items[count - 2].c_str(), nullptr, 10) });
+            code.push_back(Instr{ OP_DECL, 0 });
+        }
+        else if (last == "DIM" && count == 4) {
+            //   DIM
+            TokenType type = items[0] == "INTEGER" ? TT_INTEGER : TT_REAL;
+            code.push_back(Instr{ OP_TYPE, (uint32_t)type });
+            code.push_back(Instr{ OP_SYMBOL, addSymbol(items[1], SYM_VARIABLE, type) });
+            code.push_back(Instr{ OP_COUNT, (uint32_t)std::strtoul(items[2].c_str(), nullptr, 10) });
+            code.push_back(Instr{ OP_DIM, 0 });
+        }
+        else if (last == "CALL") {
+            // ... N CALL
+            code.push_back(Instr{ OP_SYMBOL, addSymbol(items[0], SYM_PROCEDURE) });
+            addExpression(items, 1, count - 2);
+            code.push_back(Instr{ OP_COUNT, (uint32_t)std::strtoul(items[count - 2].c_str(), nullptr, 10) });
+            code.push_back(Instr{ OP_CALL, 0 });
+        }
+        else {
+            //  =
+            code.push_back(Instr{ OP_SYMBOL, addSymbol(items[0], SYM_VARIABLE) });
+            addExpression(items, 1, count - 1);
+            code.push_back(Instr{ OP_ASSIGN, 0 });
+        }
+    }
+    pool = nullptr;
+}
+
+std::string ObjectCode::instrToString(const Instr& instr) const {
+    switch (instr.op) {
+    case OP_SYMBOL: return symbols[instr.arg].name;
+    case OP_CONST: return constants[instr.arg].text;
+    case OP_TYPE: return instr.arg == TT_INTEGER ? "INTEGER" : "REAL";
+    case OP_COUNT: return std::to_string(instr.arg);
+    case OP_ADD: return "+";
+    case OP_SUB: return "-";
+    case OP_ADD_I: return "ADD_I";
+    case OP_ADD_R: return "ADD_R";
+    case OP_SUB_I: return "SUB_I";
+    case OP_SUB_R: return "SUB_R";
+    case OP_VADD_I: return "VADD_I";
+    case OP_VADD_R: return "VADD_R";
+    case OP_VSUB_I: return "VSUB_I";
+    case OP_VSUB_R: return "VSUB_R";
+    case OP_I2R: return "I2R";
+    case OP_ASSIGN: return "=";
+    case OP_DECL: return "DECL";
+    case OP_DIM: return "DIM";
+    case OP_CALL: return "CALL";
+    case OP_PROGRAM: return "PROGRAM";
+    case OP_END: return "END";
+    default: return "?";
+    }
+}
+
+std::vector<std::string> ObjectCode::disassemble() const {
+    std::vector<std::string> result;
+
+    for (size_t n = 0; n < lines.size(); n++) {
+        size_t from = lines[n].firstInstr;
+        size_t to = n + 1 < lines.size() ? lines[n + 1].firstInstr : code.size();
+
+        std::string text;
+        for (size_t i = from; i < to; i++) {
+            if (i > from) text += " ";
+            text += instrToString(code[i]);
+        }
+        result.push_back(text);
+    }
+    return result;
+}
+
+bool ObjectCode::write(const std::string& path) const {
+    TraceSpan span("ObjectCode::write");
+    std::string strings;
+    std::vector<ObjInstr> objCode;
+    std::vector<ObjConst> objConsts;
+    std::vector<ObjSymbol> objSymbols;
+    std::vector<ObjLine> objLines;
+
+    for (const auto& instr : code) {
+        objCode.push_back(ObjInstr{ (uint32_t)instr.op, instr.arg });
+    }
+    for (const auto& c : constants) {
+        objConsts.push_back(ObjConst{ (uint32_t)c.type, (uint32_t)strings.size(), (uint32_t)c.text.size(), 0,
+            c.intValue, c.realValue });
+        strings += c.text;
+    }
+    for (const auto& sym : symbols) {
+        objSymbols.push_back(ObjSymbol{ (uint32_t)strings.size(), (uint32_t)sym.name.size(),
+            (uint32_t)sym.kind, (uint32_t)sym.type });
+        strings += sym.name;
+    }
+    for (const auto& line : lines) {
+        objLines.push_back(ObjLine{ line.firstInstr, line.sourceLine });
+    }
+
+    ObjHeader header;
+    std::memcpy(header.magic, OBJ_MAGIC, 4);
+    header.version = OBJ_VERSION;
+    header.codeCount = (uint32_t)objCode.size();
+    header.codeOffset = sizeof(ObjHeader);
+    header.constCount = (uint32_t)objConsts.size();
+    header.constOffset = header.codeOffset + header.codeCount * sizeof(ObjInstr);
+    header.symbolCount = (uint32_t)objSymbols.size();
+    header.symbolOffset = header.constOffset + header.constCount * sizeof(ObjConst);
+    header.lineCount = (uint32_t)objLines.size();
+    header.lineOffset = header.symbolOffset + header.symbolCount * sizeof(ObjSymbol);
+    header.stringsSize = (uint32_t)strings.size();
+    header.stringsOffset = header.lineOffset + header.lineCount * sizeof(ObjLine);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(objCode.data()), objCode.size() * sizeof(ObjInstr));
+    out.write(reinterpret_cast<const char*>(objConsts.data()), objConsts.size() * sizeof(ObjConst));
+    out.write(reinterpret_cast<const char*>(objSymbols.data()), objSymbols.size() * sizeof(ObjSymbol));
+    out.write(reinterpret_cast<const char*>(objLines.data()), objLines.size() * sizeof(ObjLine));
+    out.write(strings.data(), strings.size());
+    return out.good();
+}
+
+bool ObjectCode::read(const std::string& path) {
+    clear();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    ObjHeader header;
+    if (data.size() < sizeof(header)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, OBJ_MAGIC, 4) != 0 || header.version != OBJ_VERSION) return false;
+
+    auto fits = [&](uint32_t offset, uint64_t bytes) { return offset + bytes <= data.size(); };
+    if (!fits(header.codeOffset, (uint64_t)header.codeCount * sizeof(ObjInstr)) ||
+        !fits(header.constOffset, (uint64_t)header.constCount * sizeof(ObjConst)) ||
+        !fits(header.symbolOffset, (uint64_t)header.symbolCount * sizeof(ObjSymbol)) ||
+        !fits(header.lineOffset, (uint64_t)header.lineCount * sizeof(ObjLine)) ||
+        !fits(header.stringsOffset, header.stringsSize)) {
+        return false;
+    }
+
+    //    :        
+    std::vector<ObjInstr> objCode(header.codeCount);
+    std::vector<ObjConst> objConsts(header.constCount);
+    std::vector<ObjSymbol> objSymbols(header.symbolCount);
+    std::vector<ObjLine> objLines(header.lineCount);
+    std::memcpy(objCode.data(), data.data() + header.codeOffset, objCode.size() * sizeof(ObjInstr));
+    std::memcpy(objConsts.data(), data.data() + header.constOffset, objConsts.size() * sizeof(ObjConst));
+    std::memcpy(objSymbols.data(), data.data() + header.symbolOffset, objSymbols.size() * sizeof(ObjSymbol));
+    std::memcpy(objLines.data(), data.data() + header.lineOffset, objLines.size() * sizeof(ObjLine));
+
+    return load(ObjTables{ objCode.data(), header.codeCount, objConsts.data(), header.constCount,
+        objSymbols.data(), header.symbolCount, objLines.data(), header.lineCount,
+        data.data() + header.stringsOffset, header.stringsSize });
+}
+
+bool ObjectCode::load(const ObjTables& tables) {
+    clear();
+
+    auto stringAt = [&](uint32_t offset, uint32_t length) {
+        if ((uint64_t)offset + length > tables.stringsSize) return std::string();
+        return std::string(tables.strings + offset, length);
+    };
+
+    for (uint32_t i = 0; i < tables.codeCount; i++) {
+        const ObjInstr& rec = tables.code[i];
+        code.push_back(Instr{ (OpCode)rec.op, rec.arg });
+    }
+    for (uint32_t i = 0; i < tables.constCount; i++) {
+        const ObjConst& rec = tables.constants[i];
+        constants.push_back(Constant{ (TokenType)rec.type, rec.intValue, rec.realValue, stringAt(rec.text, rec.textLength) });
+    }
+    for (uint32_t i = 0; i < tables.symbolCount; i++) {
+        const ObjSymbol& rec = tables.symbols[i];
+        symbols.push_back(Symbol{ stringAt(rec.name, rec.nameLength), (SymbolKind)rec.kind, (TokenType)rec.type });
+    }
+    //    :        
+    for (uint32_t i = 0; i < tables.lineCount; i++) {
+        uint32_t firstInstr = tables.lines[i].firstInstr;
+        if (firstInstr > code.size() || (!lines.empty() && firstInstr < lines.back().firstInstr)) {
+            clear();
+            return false;
+        }
+        lines.push_back(LineEntry{ firstInstr, tables.lines[i].sourceLine });
+    }
+
+    //        
+    for (const auto& instr : code) {
+        if ((instr.op == OP_SYMBOL && instr.arg >= symbols.size()) ||
+            (instr.op == OP_CONST && instr.arg >= constants.size()) || instr.op > OP_END) {
+            clear();
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+#include "Token.h"
+#include "ConstantPool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+//  :       
+enum OpCode : uint8_t {
+    OP_SYMBOL,      //    (arg -  )
+    OP_CONST,       //  (arg -    )
+    OP_TYPE,        //   (arg - TT_INTEGER  TT_REAL)
+    OP_COUNT,       //   DECL  CALL,    DIM (arg - )
+    OP_ADD,         //+ (,   )
+    OP_SUB,         //-
+    OP_ADD_I,
+    OP_ADD_R,
+    OP_SUB_I,
+    OP_SUB_R,
+    OP_VADD_I,      //   
+    OP_VADD_R,
+    OP_VSUB_I,
+    OP_VSUB_R,
+    OP_I2R,         //INTEGER -> REAL   
+    OP_ASSIGN,      //=
+    OP_DECL,
+    OP_DIM,         // 
+    OP_CALL,
+    OP_PROGRAM,
+    OP_END
+};
+
+enum SymbolKind {
+    SYM_VARIABLE,
+    SYM_PROCEDURE,
+    SYM_PROGRAM
+};
+
+struct Instr {
+    OpCode op;
+    uint32_t arg;
+};
+
+struct Constant {
+    TokenType type;         //TT_INTEGER  TT_REAL
+    long long intValue;
+    double realValue;
+    std::string text;       //    
+};
+
+struct Symbol {
+    std::string name;
+    SymbolKind kind;
+    TokenType type;         //   , TT_UNKNOWN  
+};
+
+//           
+struct LineEntry {
+    uint32_t firstInstr;
+    int sourceLine;
+};
+
+//  : , , , , ,  
+const char OBJ_MAGIC[4] = { 'Y', 'O', 'B', 'J' };
+const uint32_t OBJ_VERSION = 3;
+
+struct ObjHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t codeCount;
+    uint32_t codeOffset;
+    uint32_t constCount;
+    uint32_t constOffset;
+    uint32_t symbolCount;
+    uint32_t symbolOffset;
+    uint32_t lineCount;
+    uint32_t lineOffset;
+    uint32_t stringsSize;
+    uint32_t stringsOffset;
+};
+
+struct ObjInstr {
+    uint32_t op;
+    uint32_t arg;
+};
+
+struct ObjConst {
+    uint32_t type;
+    uint32_t text;
+    uint32_t textLength;
+    uint32_t reserved;
+    int64_t intValue;
+    double realValue;
+};
+
+struct ObjSymbol {
+    uint32_t name;
+    uint32_t nameLength;
+    uint32_t kind;
+    uint32_t type;
+};
+
+struct ObjLine {
+    uint32_t firstInstr;
+    int32_t sourceLine;
+};
+
+//    :    read   
+//    ,    (Embedded.h)
+struct ObjTables {
+    const ObjInstr* code;
+    uint32_t codeCount;
+    const ObjConst* constants;
+    uint32_t constCount;
+    const ObjSymbol* symbols;
+    uint32_t symbolCount;
+    const ObjLine* lines;
+    uint32_t lineCount;
+    const char* strings;
+    uint32_t stringsSize;
+};
+
+//      (  )
+std::vector<std::string> splitPostfix(const std::string& line);
+
+//   : 2 - + - ADD_I ADD_R SUB_I SUB_R   VADD_I ... VSUB_R,
+//1 - I2R, 0 -  
+int postfixArity(const std::string& item);
+
+//  :     ,
+//         
+class ObjectCode {
+public:
+    //     constants,   
+    void build(const std::vector<std::string>& postfix, const std::vector<int>& postfixLines,
+        const ConstantPool* constants = nullptr);
+
+    bool write(const std::string& path) const;
+    bool read(const std::string& path);
+    bool load(const ObjTables& tables);
+
+    // ,     
+    std::vector<std::string> disassemble() const;
+    std::string instrToString(const Instr& instr) const;
+
+    const std::vector<Instr>& getCode() const { return code; }
+    const std::vector<Constant>& getConstants() const { return constants; }
+    const std::vector<Symbol>& getSymbols() const { return symbols; }
+    const std::vector<LineEntry>& getLines() const { return lines; }
+
+private:
+    std::vector<Instr> code;
+    std::vector<Constant> constants;
+    std::vector<Symbol> symbols;
+    std::vector<LineEntry> lines;
+
+    std::map<std::string, uint32_t> constIndex;
+    std::map<std::pair<std::string, int>, uint32_t> symbolIndex;
+    const ConstantPool* pool = nullptr;
+
+    void clear();
+    uint32_t addConst(const std::string& text);
+    uint32_t addSymbol(const std::string& name, SymbolKind kind, TokenType type = TT_UNKNOWN);
+    void addExpression(const std::vector<std::string>& items, size_t from, size_t to);
+};
\ No newline at end of file
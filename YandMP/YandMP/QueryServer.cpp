@@ -0,0 +1,266 @@
+#include "QueryServer.h"
+#include "Lexer.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef SOCKET Socket;
+static const Socket NO_SOCKET = INVALID_SOCKET;
+static void closeSocket(Socket socket) { closesocket(socket); }
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int Socket;
+static const Socket NO_SOCKET = -1;
+static void closeSocket(Socket socket) { close(socket); }
+#endif
+
+//   :          
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+
+static const char* const kindNames[] = { "program", "variable", "procedure" };
+
+static void deleteTree(Node* node) {
+    if (!node) return;
+    for (Node* child : node->children) {
+        deleteTree(child);
+    }
+    delete node;
+}
+
+//     
+static std::string jsonString(const std::string& text) {
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result.push_back('\\');
+            result.push_back(c);
+        }
+        else if ((unsigned char)c < 0x20) {
+            static const char hex[] = "0123456789abcdef";
+            result += "\\u00";
+            result.push_back(hex[(c >> 4) & 0xF]);
+            result.push_back(hex[c & 0xF]);
+        }
+        else {
+            result.push_back(c);
+        }
+    }
+    return result + "\"";
+}
+
+QueryServer::QueryServer(const CompileFiles& compileFiles)
+    : files(compileFiles), discard(&nullBuffer), tree(nullptr), analyzer(nullptr), running(false) {
+}
+
+QueryServer::~QueryServer() {
+    freeProgram();
+}
+
+void QueryServer::freeProgram() {
+    delete analyzer;
+    analyzer = nullptr;
+    deleteTree(tree);
+    tree = nullptr;
+}
+
+bool QueryServer::load(const CancelToken* cancel) {
+    if (!std::ifstream(files.inFile).is_open()) return false;
+
+    //          
+    Lexer lexer(files.inFile, discard);
+    lexer.setCancel(cancel);
+    lexer.run();
+    if (lexer.isCancelled()) throw CompilationCancelled(!cancel->isCancelled());
+    std::vector<Token> tokens = lexer.getTokens();
+
+    std::vector<Token> validTokens;
+    for (const auto& token : tokens) {
+        if (token.getType() != TT_ERROR && token.getType() != TT_UNKNOWN) {
+            validTokens.push_back(token);
+        }
+    }
+
+    Synt parser(validTokens, discard);
+    parser.setCancel(cancel);
+    parser.synt();
+    if (parser.isCancelled()) {
+        deleteTree(parser.getTree());
+        throw CompilationCancelled(!cancel->isCancelled());
+    }
+
+    //     
+    SemanticAnalyzer* loaded = new SemanticAnalyzer(parser.getTree(), discard);
+    loaded->setCancel(cancel);
+    loaded->analyze();
+    if (loaded->isCancelled()) {
+        delete loaded;
+        deleteTree(parser.getTree());
+        throw CompilationCancelled(!cancel->isCancelled());
+    }
+
+    freeProgram();
+    tree = parser.getTree();
+    analyzer = loaded;
+
+    index.build(std::move(tokens), lexer.getLineStarts(), tree);
+    return true;
+}
+
+std::string QueryServer::location(const SymbolReference& reference) const {
+    std::ostringstream out;
+    out << "{\"line\":" << reference.line << ",\"column\":" << reference.column << ",\"offset\":" << reference.offset
+        << ",\"length\":" << reference.length << ",\"declaration\":" << (reference.declaration ? "true" : "false") << "}";
+    return out.str();
+}
+
+std::string QueryServer::answer(const std::string& request) {
+    std::istringstream in(request);
+    std::string command;
+    int line = 0;
+    int column = 0;
+    in >> command;
+
+    if (command == "reload") {
+        long long deadline = 0;
+        in >> deadline;
+        CancelToken cancel;
+        if (deadline > 0) cancel.setTimeout(deadline);
+        try {
+            if (!load(deadline > 0 ? &cancel : nullptr)) return "{\"error\":\"cannot open input file\"}";
+        }
+        catch (const CompilationCancelled& cancelled) {
+            return "{\"error\":" + jsonString(cancelled.what()) + "}";
+        }
+        return "{\"tokens\":" + std::to_string(index.getTokenCount()) +
+            ",\"references\":" + std::to_string(index.getReferenceCount()) + "}";
+    }
+    if (command == "quit" || command == "shutdown") {
+        return "{\"ok\":true}";
+    }
+    if (command != "token" && command != "declaration" && command != "references") {
+        return "{\"error\":\"unknown command\"}";
+    }
+    if (!(in >> line >> column)) {
+        return "{\"error\":\"expected line and column\"}";
+    }
+
+    size_t offset = index.toOffset(line, column);
+    const SymbolReference* reference = offset == std::string::npos ? nullptr : index.referenceAt(offset);
+
+    if (command == "token") {
+        const Token* token = offset == std::string::npos ? nullptr : index.tokenAt(offset);
+        if (!token) return "null";
+
+        std::ostringstream out;
+        out << "{\"token\":" << jsonString(token->getLexeme()) << ",\"type\":\"" << token->typeToString()
+            << "\",\"line\":" << token->getLine() << ",\"column\":" << token->getColumn()
+            << ",\"offset\":" << token->getOffset() << ",\"length\":" << token->getLexeme().size();
+        if (reference) {
+            const std::string& name = index.symbolName(*reference);
+            out << ",\"symbol\":" << jsonString(name) << ",\"kind\":\"" << kindNames[reference->kind]
+                << "\",\"declaration\":" << (reference->declaration ? "true" : "false");
+            const VarInfo* var = reference->kind == NAME_VARIABLE ? analyzer->getVariable(name) : nullptr;
+            if (var) out << ",\"varType\":\"" << var->typeToString() << "\"";
+        }
+        out << "}";
+        return out.str();
+    }
+
+    if (command == "declaration") {
+        const SymbolReference* declaration = reference ? index.declarationOf(*reference) : nullptr;
+        return declaration ? location(*declaration) : "null";
+    }
+
+    std::string result = "[";
+    if (reference) {
+        for (const SymbolReference* each : index.referencesOf(*reference)) {
+            if (result.size() > 1) result += ",";
+            result += location(*each);
+        }
+    }
+    return result + "]";
+}
+
+//      ,   
+//   ,  Nagle    
+bool QueryServer::serve(int port) {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+#endif
+
+    Socket listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == NO_SOCKET) return false;
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 4) != 0) {
+        closeSocket(listener);
+        return false;
+    }
+    std::cout << "Query server listening on 127.0.0.1:" << port << std::endl;
+
+    running = true;
+    while (running) {
+        Socket client = accept(listener, nullptr, nullptr);
+        if (client == NO_SOCKET) continue;
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+
+        std::string pending;
+        char buffer[4096];
+        bool open = true;
+        while (open) {
+            int received = (int)recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) break;
+            pending.append(buffer, received);
+
+            size_t end;
+            while (open && (end = pending.find('\n')) != std::string::npos) {
+                std::string request = pending.substr(0, end);
+                pending.erase(0, end + 1);
+                if (!request.empty() && request.back() == '\r') request.pop_back();
+
+                std::string response = answer(request) + "\n";
+                for (size_t sent = 0; sent < response.size();) {
+                    int count = (int)send(client, response.data() + sent, (int)(response.size() - sent), SEND_FLAGS);
+                    if (count <= 0) {
+                        open = false;
+                        break;
+                    }
+                    sent += count;
+                }
+
+                if (request == "quit") open = false;
+                if (request == "shutdown") {
+                    open = false;
+                    running = false;
+                }
+            }
+        }
+        closeSocket(client);
+    }
+
+    closeSocket(listener);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return true;
+}
\ No newline at end of file
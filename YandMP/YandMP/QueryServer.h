@@ -0,0 +1,54 @@
+#pragma once
+#include "Compiler.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "SourceIndex.h"
+#include "Cancel.h"
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+//      (127.0.0.1). , ,
+//         .
+//   -   ;  - JSON:
+//  token L C            L,  C
+//  declaration L C      
+//  references L C        
+//  reload [MS]            MS ;
+//                        
+//  quit               
+//  shutdown           
+class QueryServer {
+public:
+    QueryServer(const CompileFiles& compileFiles);
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    //    ; false -   .
+    //   CompilationCancelled,   
+    bool load(const CancelToken* cancel = nullptr);
+    //    
+    std::string answer(const std::string& request);
+    //      shutdown; false -   
+    bool serve(int port);
+
+private:
+    //    
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    };
+
+    CompileFiles files;
+    NullBuffer nullBuffer;
+    std::ostream discard;
+    Node* tree;
+    SemanticAnalyzer* analyzer;
+    SourceIndex index;
+    bool running;
+
+    std::string location(const SymbolReference& reference) const;
+    void freeProgram();
+};
\ No newline at end of file
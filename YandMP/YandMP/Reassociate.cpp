@@ -0,0 +1,163 @@
+#include "Reassociate.h"
+#include "ObjectCode.h"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+//  : 'I' -  ADD_I/SUB_I, 'R' -   fastMath, 0 -  
+char Reassociator::family(const std::string& op) const {
+    if (op == "ADD_I" || op == "SUB_I") return 'I';
+    if (fastMath && (op == "ADD_R" || op == "SUB_R")) return 'R';
+    return 0;
+}
+
+bool Reassociator::parse(const std::vector<std::string>& items, size_t from, size_t to, std::vector<int>& roots) {
+    for (size_t i = from; i < to; i++) {
+        const std::string& item = items[i];
+        int arity = postfixArity(item);
+
+        if (arity == 0) {
+            terms.push_back(Term{ "", -1, -1, item, 0, 0 });
+        }
+        else if (arity == 1) {
+            if (roots.empty()) return false;
+            int operand = roots.back();
+            roots.pop_back();
+            terms.push_back(Term{ item, operand, -1, "", terms[operand].height + 1, 0 });
+        }
+        else {
+            if (roots.size() < 2) return false;
+            int right = roots.back();
+            roots.pop_back();
+            int left = roots.back();
+            roots.pop_back();
+
+            char kind = family(item);
+            int chain = 0;
+            if (kind) {
+                int l = family(terms[left].op) == kind ? terms[left].chain : 0;
+                int r = family(terms[right].op) == kind ? terms[right].chain : 0;
+                chain = std::max(l, r) + 1;
+            }
+            terms.push_back(Term{ item, left, right, "", std::max(terms[left].height, terms[right].height) + 1, chain });
+        }
+        roots.push_back((int)terms.size() - 1);
+    }
+    return true;
+}
+
+//  from..to  .   - 
+//   "+"  "-"   : "-"     
+// .     
+//   ,    
+int Reassociator::merge(const std::vector<int>& operands, const std::vector<size_t>& positive, size_t from, size_t to,
+    char kind, std::vector<std::string>& out) {
+    if (to - from == 1) return render(operands[from], out);
+
+    size_t middle = (from + to) / 2;
+    bool leftPositive = positive[middle] > positive[from];
+    bool rightPositive = positive[to] > positive[middle];
+    std::string suffix(1, '_');
+    suffix.push_back(kind);
+
+    int height = 0;
+    if (!leftPositive && rightPositive) {
+        height = merge(operands, positive, middle, to, kind, out);
+        height = std::max(height, merge(operands, positive, from, middle, kind, out));
+        out.push_back("SUB" + suffix);
+    }
+    else {
+        height = merge(operands, positive, from, middle, kind, out);
+        height = std::max(height, merge(operands, positive, middle, to, kind, out));
+        out.push_back((leftPositive == rightPositive ? "ADD" : "SUB") + suffix);
+    }
+    return height + 1;
+}
+
+//      ,    
+int Reassociator::render(int id, std::vector<std::string>& out) {
+    const Term& term = terms[id];
+    if (term.op.empty()) {
+        out.push_back(term.text);
+        return 0;
+    }
+    if (term.right < 0) {
+        int height = render(term.left, out) + 1;
+        out.push_back(term.op);
+        return height;
+    }
+
+    char kind = family(term.op);
+    if (kind) {
+        //   ;  -      
+        std::vector<int> operands;
+        std::vector<size_t> positive(1, 0);
+        std::vector<std::pair<int, bool>> pending(1, std::make_pair(id, false));
+        while (!pending.empty()) {
+            int node = pending.back().first;
+            bool negative = pending.back().second;
+            pending.pop_back();
+
+            const Term& each = terms[node];
+            if (family(each.op) == kind) {
+                pending.push_back(std::make_pair(each.right, negative != (each.op[0] == 'S')));
+                pending.push_back(std::make_pair(each.left, negative));
+            }
+            else {
+                operands.push_back(node);
+                positive.push_back(positive.back() + (negative ? 0 : 1));
+            }
+        }
+
+        int balanced = 0;
+        while (((size_t)1 << balanced) < operands.size()) balanced++;
+        if (term.chain > balanced) {
+            chains++;
+            return merge(operands, positive, 0, operands.size(), kind, out);
+        }
+    }
+
+    //   :    max  
+    int height = render(term.left, out);
+    height = std::max(height, render(term.right, out)) + 1;
+    out.push_back(term.op);
+    return height;
+}
+
+void Reassociator::reassociate(std::vector<std::string>& postfix) {
+    for (auto& line : postfix) {
+        std::vector<std::string> items;
+        std::istringstream stream(line);
+        std::string item;
+        while (stream >> item) items.push_back(item);
+        if (items.size() < 3) continue;
+
+        //  = |  ... N CALL
+        const std::string& last = items.back();
+        size_t from = 1;
+        size_t to = 0;
+        if (last == "=") to = items.size() - 1;
+        else if (last == "CALL") to = items.size() - 2;
+        else continue;
+
+        terms.clear();
+        std::vector<int> roots;
+        if (!parse(items, from, to, roots)) continue;
+
+        std::vector<std::string> out(items.begin(), items.begin() + from);
+        size_t before = chains;
+        for (int root : roots) {
+            depthBefore = std::max(depthBefore, terms[root].height);
+            depthAfter = std::max(depthAfter, render(root, out));
+        }
+        if (chains == before) continue;
+
+        out.insert(out.end(), items.begin() + to, items.end());
+        std::string result;
+        for (const auto& each : out) {
+            if (!result.empty()) result += " ";
+            result += each;
+        }
+        line = result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//   .      
+//   ("a b c d ADD_I ADD_I ADD_I"),     
+//.         
+//      log2(n)    
+//.      2^64,   ;
+//        fastMath
+class Reassociator {
+public:
+    Reassociator() : fastMath(false), chains(0), depthBefore(0), depthAfter(0) {}
+
+    void setFastMath(bool enabled) { fastMath = enabled; }
+
+    //     ;    
+    void reassociate(std::vector<std::string>& postfix);
+
+    size_t getChains() const { return chains; }            // 
+    int getDepthBefore() const { return depthBefore; }     //     
+    int getDepthAfter() const { return depthAfter; }
+
+private:
+    struct Term {
+        std::string op;         //     
+        int left;
+        int right;              //-1   I2R
+        std::string text;       //    
+        int height;             // 
+        int chain;              //        
+    };
+
+    bool fastMath;
+    size_t chains;
+    int depthBefore;
+    int depthAfter;
+
+    std::vector<Term> terms;    //  
+
+    char family(const std::string& op) const;
+    bool parse(const std::vector<std::string>& items, size_t from, size_t to, std::vector<int>& roots);
+    int render(int id, std::vector<std::string>& out);
+    int merge(const std::vector<int>& operands, const std::vector<size_t>& positive, size_t from, size_t to,
+        char kind, std::vector<std::string>& out);
+};
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "SelfTest.h"
+#include "Embedded.h"
+#include "Lexer.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "ObjectCode.h"
+#include "VirtualMachine.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+//, ,    :   constexpr-
+//       YAMP_EMBED
+static constexpr char selfTestSource[] =
+    "PROGRAM Sample\n"
+    "INTEGER count, total, items(3)\n"
+    "REAL ratio, values(3)\n"
+    "count = 2\n"
+    "total = count + 40 - (count - 1)\n"
+    "items = items + total\n"
+    "ratio = 0.5 + count\n"
+    "values = items - ratio + 1.25\n"
+    "CALL Print(total, ratio, values)\n"
+    "END Sample";
+
+YAMP_EMBED(selfTestProgram, selfTestSource);
+
+//  +  -   :  -O  
+//  ,     .
+//  ,      
+static const char* const optimizeTestSource =
+    "PROGRAM Chains\n"
+    "INTEGER ia, ib, ic, id, ie\n"
+    "ie = ((ib + ic) + (ic - 5) - 4) - ia - ic - (1 - 2) + id\n"
+    "ia = ie - 7 + (ib - ie - 3) - (ic + 2 - ie) + ie - 9 - id + 1\n"
+    "ib = (ia - ie) - (3 - ia - ie - 8 - ia) + 12 - ie - (ia - 4 + ie - 1) - 6\n"
+    "ic = 0 - (ib - ia - ie - (ib + 5 - ia) - 11 + ie) - ia - ib - ie + 2\n"
+    "CALL Print (ia, ib, ic, id, ie)\n"
+    "END Chains";
+
+static void deleteTree(Node* node) {
+    if (!node) return;
+    for (auto child : node->children) {
+        deleteTree(child);
+    }
+    delete node;
+}
+
+//  ,    ,   compileFile
+static bool compileSource(const std::string& source, bool optimize, ObjectCode& object) {
+    std::ostream nullOutput(nullptr);
+    std::vector<Token> validTokens;
+    for (const auto& token : Lexer::tokenize(source)) {
+        if (token.getType() != TT_ERROR && token.getType() != TT_UNKNOWN) {
+            validTokens.push_back(token);
+        }
+    }
+    Synt parser(validTokens, nullOutput);
+    parser.synt();
+    SemanticAnalyzer analyzer(parser.getTree(), nullOutput);
+    analyzer.setOptimize(optimize);
+    analyzer.analyze();
+    bool valid = parser.getErrors().empty() && analyzer.getErrorCount() == 0;
+    if (valid) object.build(analyzer.getPostfixCode(), analyzer.getPostfixLines());
+    deleteTree(parser.getTree());
+    return valid;
+}
+
+static bool runProgram(const ObjectCode& object, std::string& output, std::ostream& report) {
+    VirtualMachine vm;
+    if (!vm.load(object)) {
+        report << vm.getError() << "\n";
+        return false;
+    }
+    std::ostringstream out;
+    vm.run(out);
+    //    :     
+    output = out.str();
+    while (!output.empty() && output.back() == '\n') output.pop_back();
+    return true;
+}
+
+bool runSelfTest(std::ostream& report) {
+    ObjectCode embedded;
+    if (!selfTestProgram.load(embedded)) {
+        report << "Embedded program: object code rejected\n";
+        return false;
+    }
+    ObjectCode compiled;
+    if (!compileSource(selfTestSource, false, compiled)) {
+        report << "Compiled program: errors in the sample program\n";
+        return false;
+    }
+
+    bool passed = true;
+    if (embedded.disassemble() != compiled.disassemble()) {
+        report << "Object code differs\n";
+        passed = false;
+    }
+    const std::vector<LineEntry>& embeddedLines = embedded.getLines();
+    const std::vector<LineEntry>& compiledLines = compiled.getLines();
+    bool sameLines = embeddedLines.size() == compiledLines.size();
+    for (size_t i = 0; sameLines && i < embeddedLines.size(); i++) {
+        sameLines = embeddedLines[i].firstInstr == compiledLines[i].firstInstr
+            && embeddedLines[i].sourceLine == compiledLines[i].sourceLine;
+    }
+    if (!sameLines) {
+        report << "Line table differs\n";
+        passed = false;
+    }
+
+    std::string embeddedOutput, compiledOutput;
+    if (!runProgram(embedded, embeddedOutput, report) || !runProgram(compiled, compiledOutput, report)) return false;
+    if (embeddedOutput != compiledOutput) {
+        report << "Program output differs\n";
+        passed = false;
+    }
+
+    //    
+    ObjectCode plain, optimized;
+    std::string plainOutput, optimizedOutput;
+    if (!compileSource(optimizeTestSource, false, plain) || !compileSource(optimizeTestSource, true, optimized)) {
+        report << "Optimization test: errors in the sample program\n";
+        return false;
+    }
+    if (!runProgram(plain, plainOutput, report) || !runProgram(optimized, optimizedOutput, report)) return false;
+    if (plainOutput != optimizedOutput) {
+        report << "Optimized program output differs\n-O: " << optimizedOutput << "\nwithout -O: " << plainOutput << "\n";
+        passed = false;
+    }
+
+    report << "Instructions: " << embedded.getCode().size() << ", output: " << embeddedOutput << "\n";
+    report << (passed ? "Self-test passed\n" : "Self-test failed\n");
+    return passed;
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+#include <ostream>
+
+// :     (Embedded.h) 
+//   ,   ,    ;
+//    +  -   -O   .
+//false -      
+bool runSelfTest(std::ostream& report);
\ No newline at end of file
@@ -1,14 +1,19 @@
 #include "Semantic.h"
+#include "Trace.h"
+#include "Dataflow.h"
+#include <cctype>
+#include <cstdlib>
 #include <sstream>
 #include <iomanip>
 #include <stack>
 #include <algorithm>
 
-SemanticAnalyzer::SemanticAnalyzer(Node* root, std::ofstream& outputStream)
-    : astRoot(root), output(outputStream), programName(""), varTable(211) {
+SemanticAnalyzer::SemanticAnalyzer(Node* root, std::ostream& outputStream)
+    : astRoot(root), output(outputStream), budget(nullptr), stopped(false), varTable(211), symbolLookups(0), programName(""), optimize(false) {
 }
 
 VarInfo* SemanticAnalyzer::findVar(const std::string& name) {
+    symbolLookups++;
     int idx = varTable.findIndex(name);
     if (idx != -1) {
         return varTable.getValue(idx);
@@ -17,29 +22,116 @@ VarInfo* SemanticAnalyzer::findVar(const std::string& name) {
 }
 
 void SemanticAnalyzer::analyze() {
+    TraceSpan span("SemanticAnalyzer::analyze");
     if (!astRoot) {
         output << "ERROR: AST is empty\n";
         return;
     }
 
-    processDescriptionsNode(astRoot);
-    processOperatorsNode(astRoot);
-    processEndNode(astRoot);
+    {
+        TraceSpan pass("SemanticAnalyzer::processDescriptions", TRACE_PASSES);
+        processDescriptionsNode(astRoot);
+    }
+    {
+        TraceSpan pass("SemanticAnalyzer::processOperators", TRACE_PASSES);
+        processOperatorsNode(astRoot);
+        if (!cancelPoll.isStopped()) processEndNode(astRoot);
+    }
+
+    //    ;    
+    if (optimize && !cancelPoll.isStopped()) {
+        {
+            //   :      
+            TraceSpan pass("Reassociator::reassociate", TRACE_PASSES);
+            reassociator.reassociate(postfixCode);
+        }
+        if (!cancelPoll.check()) {
+            TraceSpan pass("ExpressionDag::eliminate", TRACE_PASSES);
+            dag.eliminate(postfixCode, postfixLines);
+        }
+    }
+    //    ,      
+    if (!cancelPoll.check()) {
+        TraceSpan pass("Dataflow", TRACE_PASSES);
+        Dataflow dataflow(postfixCode, postfixLines);
+        warnings = dataflow.getWarnings();
+        if (optimize) dataflow.eliminateDeadCode(postfixCode, postfixLines);
+    }
+    if (cancelPoll.isStopped()) {
+        output << "Semantic analysis cancelled";
+        return;
+    }
+
+    TraceSpan writing("SemanticAnalyzer::write", TRACE_PASSES);
+
+    for (const auto& line : postfixCode) {
+        output << line << "\n";
+    }
+
+    if (!warnings.empty()) {
+        output << "\nWARNINGS:\n";
+        for (const auto& warning : warnings) {
+            output << warning << "\n";
+        }
+    }
 
     if (!errors.empty()) {
         output << "\nERRORS:\n";
         for (const auto& error : errors) {
-            output << error << std::endl;
+            output << formatError(error) << "\n";
         }
-        output << "\nSemantic analysis completed with " << errors.size() << " error(s)";
+        output << "\nSemantic analysis " << (stopped ? "stopped after " : "completed with ") << errors.size() << " error(s)";
+    }
+    else if (stopped) {
+        //    
+        output << "\nSemantic analysis stopped: error limit reached";
     }
     else {
         output << "\nSemantic analysis completed successfully!";
     }
 }
 
+//       
+void SemanticAnalyzer::emit(const std::string& code, int line) {
+    std::string text = optimize ? folder.fold(code) : code;
+    postfixCode.push_back(text);
+    postfixLines.push_back(line);
+}
+
+void SemanticAnalyzer::analyzeStatement(Node* stmt, std::vector<std::string>& stmtPostfix,
+    std::vector<std::string>& stmtErrors) {
+    size_t codeStart = postfixCode.size();
+    size_t errorsStart = errors.size();
+
+    if (stmt->name == "Begin") {
+        processBegin(stmt);
+    }
+    else if (stmt->name == "Descr") {
+        TokenType currentType = TT_UNKNOWN;
+        processDescr(stmt, currentType);
+    }
+    else if (stmt->name == "Op") {
+        processOpNode(stmt);
+    }
+    else if (stmt->name == "End") {
+        processEnd(stmt);
+    }
+
+    stmtPostfix.assign(postfixCode.begin() + codeStart, postfixCode.end());
+    stmtErrors.clear();
+    for (size_t i = errorsStart; i < errors.size(); i++) {
+        stmtErrors.push_back(formatError(errors[i]));
+    }
+
+    //   ,      
+    postfixCode.resize(codeStart);
+    postfixLines.resize(codeStart);
+    errors.resize(errorsStart);
+}
+
 void SemanticAnalyzer::processDescriptionsNode(Node* node) {
-    if (!node) return;
+    //     
+    if (!node || cancelPoll.poll()) return;
 
     if (node->name == "Begin") {
         processBegin(node);
@@ -49,23 +141,9 @@ void SemanticAnalyzer::processDescriptionsNode(Node* node) {
         TokenType currentType = TT_UNKNOWN;
 
         for (auto child : node->children) {
+            if (interrupted()) return;
             if (child->name == "Descr") {
-                //    Descr
-                for (auto descrChild : child->children) {
-                    if (descrChild->name == "Type") {
-                        for (auto typeChild : descrChild->children) {
-                            if (typeChild->value == "INTEGER") {
-                                currentType = TT_INTEGER;
-                            }
-                            else if (typeChild->value == "REAL") {
-                                currentType = TT_REAL;
-                            }
-                        }
-                    }
-                    else if (descrChild->name == "VarList") {
-                        processVarList(descrChild, currentType);
-                    }
-                }
+                processDescr(child, currentType);
             }
         }
     }
@@ -75,12 +153,43 @@ void SemanticAnalyzer::processDescriptionsNode(Node* node) {
     }
 }
 
+//  -   ;     
+static int firstLine(const Node* node) {
+    if (node->lineNumber >= 0) return node->lineNumber;
+    for (auto child : node->children) {
+        int line = firstLine(child);
+        if (line >= 0) return line;
+    }
+    return -1;
+}
+
+void SemanticAnalyzer::processDescr(Node* node, TokenType& currentType) {
+    TraceSpan span("SemanticAnalyzer::processDescr", TRACE_STATEMENTS, firstLine(node));
+    //    Descr
+    for (auto descrChild : node->children) {
+        if (descrChild->name == "Type") {
+            for (auto typeChild : descrChild->children) {
+                if (typeChild->value == "INTEGER") {
+                    currentType = TT_INTEGER;
+                }
+                else if (typeChild->value == "REAL") {
+                    currentType = TT_REAL;
+                }
+            }
+        }
+        else if (descrChild->name == "VarList") {
+            processVarList(descrChild, currentType);
+        }
+    }
+}
+
 void SemanticAnalyzer::processOperatorsNode(Node* node) {
-    if (!node) return;
+    if (!node || cancelPoll.poll()) return;
 
     if (node->name == "Operators") {
         //  
         for (auto child : node->children) {
+            if (interrupted()) return;
             if (child->name == "Op") {
                 processOpNode(child);
             }
@@ -103,6 +212,7 @@ void SemanticAnalyzer::processEndNode(Node* node) {
 }
 
 void SemanticAnalyzer::processOpNode(Node* node) {
+    TraceSpan span("SemanticAnalyzer::processOp", TRACE_STATEMENTS, firstLine(node));
     //    CALL
     bool isAssignment = false;
     bool isCall = false;
@@ -130,50 +240,98 @@ void SemanticAnalyzer::processOpNode(Node* node) {
     }
 }
 
+//     
+bool SemanticAnalyzer::interrupted() {
+    return cancelPoll.poll() || stopped;
+}
+
+//  ,    
+void SemanticAnalyzer::report(const Diagnostic& diagnostic) {
+    if (stopped) return;
+    if (budget && !budget->reserve()) {
+        stopped = true;
+        return;
+    }
+    errors.push_back(diagnostic);
+    if (budget && budget->isSpent()) stopped = true;
+}
+
 void SemanticAnalyzer::checkVariableDeclared(const std::string& varName, int line) {
     VarInfo* var = findVar(varName);
     if (!var) {
-        std::stringstream ss;
-        ss << "SEMANTIC ERROR at line " << line << ": Variable '" << varName << "' is not declared";
-        errors.push_back(ss.str());
+        report(Diagnostic{ DIAG_NOT_DECLARED, line, -1, varName, TT_UNKNOWN, TT_UNKNOWN });
     }
 }
 
 void SemanticAnalyzer::checkVariableNotRedeclared(const std::string& varName, int line) {
     VarInfo* var = findVar(varName);
     if (var) {
-        std::stringstream ss;
-        ss << "SEMANTIC ERROR at line " << line << ": Variable '" << varName << "' is already declared";
-        errors.push_back(ss.str());
+        report(Diagnostic{ DIAG_ALREADY_DECLARED, line, -1, varName, TT_UNKNOWN, TT_UNKNOWN });
     }
 }
 
 void SemanticAnalyzer::checkTypeCompatibility(TokenType leftType, TokenType rightType, int line) {
     if (leftType != rightType) {
-        std::stringstream ss;
-        ss << "SEMANTIC ERROR at line " << line << ": Type mismatch. Cannot assign ";
-
-        if (rightType == TT_INTEGER) ss << "INTEGER";
-        else if (rightType == TT_REAL) ss << "REAL";
-
-        ss << " to ";
-
-        if (leftType == TT_INTEGER) ss << "INTEGER";
-        else if (leftType == TT_REAL) ss << "REAL";
-
-        ss << " variable";
-        errors.push_back(ss.str());
+        report(Diagnostic{ DIAG_TYPE_MISMATCH, line, -1, "", leftType, rightType });
     }
 }
 
 void SemanticAnalyzer::checkProgramNameMatch(const std::string& endName, int line) {
     if (programName != endName) {
-        std::stringstream ss;
-        ss << "SEMANTIC ERROR at line " << line
-            << ": Program name mismatch. Expected '" << programName
-            << "', got '" << endName << "'";
-        errors.push_back(ss.str());
+        report(Diagnostic{ DIAG_PROGRAM_NAME_MISMATCH, line, -1, endName, TT_UNKNOWN, TT_UNKNOWN });
+    }
+}
+
+static const char* typeName(TokenType type) {
+    if (type == TT_INTEGER) return "INTEGER";
+    if (type == TT_REAL) return "REAL";
+    return "";
+}
+
+std::string SemanticAnalyzer::formatError(const Diagnostic& diagnostic) const {
+    std::stringstream ss;
+    ss << "SEMANTIC ERROR at line " << diagnostic.line << ": ";
+
+    switch (diagnostic.code) {
+    case DIAG_NOT_DECLARED:
+        ss << "Variable '" << diagnostic.name << "' is not declared";
+        break;
+    case DIAG_ALREADY_DECLARED:
+        ss << "Variable '" << diagnostic.name << "' is already declared";
+        break;
+    case DIAG_TYPE_MISMATCH:
+        ss << "Type mismatch. Cannot assign " << typeName(diagnostic.rightType) << " to "
+            << typeName(diagnostic.leftType) << " variable";
+        break;
+    case DIAG_PROGRAM_NAME_MISMATCH:
+        ss << "Program name mismatch. Expected '" << programName
+            << "', got '" << diagnostic.name << "'";
+        break;
+    case DIAG_INVALID_ARRAY_SIZE:
+        ss << "Size of array '" << diagnostic.name << "' must be from 1 to " << MAX_ARRAY_SIZE;
+        break;
+    case DIAG_ARRAY_SIZE_MISMATCH:
+        ss << "Arrays of different sizes in expression";
+        break;
+    case DIAG_ARRAY_ASSIGN_MISMATCH:
+        ss << "Array size mismatch in assignment to '" << diagnostic.name << "'";
+        break;
+    case DIAG_ARRAY_TO_SCALAR:
+        ss << "Cannot assign array to scalar variable '" << diagnostic.name << "'";
+        break;
+    default:
+        ss << diagnosticMessage(diagnostic.code);
+        break;
+    }
+    return ss.str();
+}
+
+std::vector<std::string> SemanticAnalyzer::getErrors() const {
+    std::vector<std::string> result;
+    for (const auto& error : errors) {
+        result.push_back(formatError(error));
     }
+    return result;
 }
 
 void SemanticAnalyzer::processBegin(Node* node) {
@@ -181,29 +339,52 @@ void SemanticAnalyzer::processBegin(Node* node) {
         if (child->name == "IDENTIFIER") {
             programName = child->value;
             std::string Postfix = programName + " PROGRAM";
-            postfixCode.push_back(Postfix);
-            output << Postfix << "\n";
+            emit(Postfix, child->lineNumber);
         }
     }
 }
 
 void SemanticAnalyzer::processVarList(Node* node, TokenType type) {
+    std::string typeStr = (type == TT_INTEGER ? "INTEGER" : "REAL");
     std::vector<std::string> varNames;
+    std::vector<Node*> arrays;
+    std::vector<int> arraySizes;
+    int declLine = -1;
 
-    //    VarList
-    for (auto child : node->children) {
+    //    VarList;      ( Const )
+    for (size_t i = 0; i < node->children.size(); i++) {
+        Node* child = node->children[i];
         if (child->name == "IDENTIFIER") {
-            std::string varName = child->value;
+            const std::string& varName = child->value;
             int line = child->lineNumber;
+            int size = 0;
+
+            if (i + 2 < node->children.size() && node->children[i + 1]->name == "LPAREN" &&
+                node->children[i + 2]->name == "INTEGER") {
+                long long elements = std::strtoll(node->children[i + 2]->value.c_str(), nullptr, 10);
+                if (elements < 1 || elements > MAX_ARRAY_SIZE) {
+                    report(Diagnostic{ DIAG_INVALID_ARRAY_SIZE, line, -1, varName, TT_UNKNOWN, TT_UNKNOWN });
+                }
+                else {
+                    size = (int)elements;
+                }
+            }
 
             checkVariableNotRedeclared(varName, line);
 
             //     
             VarInfo* existingVar = findVar(varName);
             if (!existingVar) {
-                varNames.push_back(varName);
+                if (size > 0) {
+                    arrays.push_back(child);
+                    arraySizes.push_back(size);
+                }
+                else {
+                    if (varNames.empty()) declLine = line;
+                    varNames.push_back(varName);
+                }
                 //   -
-                VarInfo info(varName, type, false);
+                VarInfo info(varName, type, size);
                 varTable.insert(varName, info);
             }
         }
@@ -211,7 +392,6 @@ void SemanticAnalyzer::processVarList(Node* node, TokenType type) {
 
     //    
     if (!varNames.empty()) {
-        std::string typeStr = (type == TT_INTEGER ? "INTEGER" : "REAL");
         std::string declPostfix = typeStr;
 
         //  
@@ -219,13 +399,17 @@ void SemanticAnalyzer::processVarList(Node* node, TokenType type) {
             declPostfix += " " + varName;
         }
         declPostfix += " " + std::to_string(varNames.size() + 1) + " DECL";
-        postfixCode.push_back(declPostfix);
-        output << declPostfix << "\n";
+        emit(declPostfix, declLine);
+    }
+
+    //   :    DIM
+    for (size_t i = 0; i < arrays.size(); i++) {
+        emit(typeStr + " " + arrays[i]->value + " " + std::to_string(arraySizes[i]) + " DIM", arrays[i]->lineNumber);
     }
 }
 
 void SemanticAnalyzer::processAssignment(Node* idNode, Node* exprNode) {
-    std::string varName = idNode->value;
+    const std::string& varName = idNode->value;
     int line = idNode->lineNumber;
 
     //  
@@ -233,26 +417,38 @@ void SemanticAnalyzer::processAssignment(Node* idNode, Node* exprNode) {
 
     //   
     std::string postfix;
-    TokenType exprType = analyzeExpression(exprNode, postfix);
+    int size = 0;
+    TokenType exprType = analyzeExpression(exprNode, postfix, size);
+    if (size < 0) {
+        report(Diagnostic{ DIAG_ARRAY_SIZE_MISMATCH, line, -1, "", TT_UNKNOWN, TT_UNKNOWN });
+    }
 
-    //  
+    //  ;     
     VarInfo* variable = findVar(varName);
     if (variable) {
         checkTypeCompatibility(variable->type, exprType, line);
-        variable->initialized = true;
+        if (size > 0 && variable->size == 0) {
+            report(Diagnostic{ DIAG_ARRAY_TO_SCALAR, line, -1, varName, TT_UNKNOWN, TT_UNKNOWN });
+        }
+        else if (size > 0 && size != variable->size) {
+            report(Diagnostic{ DIAG_ARRAY_ASSIGN_MISMATCH, line, -1, varName, TT_UNKNOWN, TT_UNKNOWN });
+        }
         std::string assignmentPostfix = varName + " " + postfix + " =";
-        postfixCode.push_back(assignmentPostfix);
-        output << assignmentPostfix << "\n";
+        emit(assignmentPostfix, line);
     }
 }
 
 void SemanticAnalyzer::processCall(Node* node) {
     std::string funcName;
     std::vector<Node*> arguments;
+    int line = -1;
 
     //    
     for (auto child : node->children) {
-        if (child->name == "IDENTIFIER" && funcName.empty()) {
+        if (child->name == "KEYWORD" && child->value == "CALL") {
+            line = child->lineNumber;
+        }
+        else if (child->name == "IDENTIFIER" && funcName.empty()) {
             funcName = child->value;
         }
         else if (child->name == "Arguments") {
@@ -267,58 +463,95 @@ void SemanticAnalyzer::processCall(Node* node) {
     std::string callPostfix = funcName + " ";
     for (auto arg : arguments) {
         std::string argPostfix;
-        //  
-        analyzeExpression(arg, argPostfix);
+        int size = 0;
+        //  ;   
+        analyzeExpression(arg, argPostfix, size);
+        if (size < 0) {
+            report(Diagnostic{ DIAG_ARRAY_SIZE_MISMATCH, line, -1, "", TT_UNKNOWN, TT_UNKNOWN });
+        }
         callPostfix += argPostfix + " ";
     }
     callPostfix += std::to_string(arguments.size() + 1) + " CALL";
-    postfixCode.push_back(callPostfix);
-    output << callPostfix << "\n";
+    emit(callPostfix, line);
 }
 
-TokenType SemanticAnalyzer::analyzeExpression(Node* exprNode, std::string& postfix) {
+TokenType SemanticAnalyzer::analyzeExpression(Node* exprNode, std::string& postfix, int& size) {
+    size = 0;
     if (!exprNode) return TT_UNKNOWN;
 
-    //   
-    expressionToPostfix(exprNode, postfix);
+    //      
+    return expressionToPostfix(exprNode, postfix, size);
+}
 
-    //        
-    bool hasReal = false;
-    bool hasInteger = false;
-    bool isMixed = checkExpressionTypes(exprNode, hasReal, hasInteger);
+//    :     (ADD_I/ADD_R,
+//SUB_I/SUB_R),       (I2R).
+//       , 
+//        .
+//    (VADD_I, VADD_R, VSUB_I, VSUB_R),
+//       
+TokenType SemanticAnalyzer::typePostfix(std::vector<std::string>& items, int& size) {
+    struct Operand {
+        TokenType type;
+        size_t start;
+        int size;
+    };
+    std::vector<Operand> stack;
+    std::vector<bool> convertAfter(items.size(), false);
+    size = 0;
+
+    for (size_t i = 0; i < items.size(); i++) {
+        const std::string& item = items[i];
+
+        if (item == "+" || item == "-") {
+            if (stack.size() < 2) return TT_UNKNOWN;
+            Operand right = stack.back();
+            stack.pop_back();
+            Operand& left = stack.back();
+
+            if (left.size < 0 || right.size < 0 || (left.size > 0 && right.size > 0 && left.size != right.size)) {
+                left.size = -1;
+            }
+            else {
+                left.size = std::max(left.size, right.size);
+            }
 
-    if (isMixed) {
-        return TT_UNKNOWN;
-    }
+            //  :   ,   
+            if (left.type == TT_UNKNOWN || right.type == TT_UNKNOWN) {
+                left.type = TT_UNKNOWN;
+                continue;
+            }
 
-    return hasReal ? TT_REAL : TT_INTEGER;
-}
-bool SemanticAnalyzer::checkExpressionTypes(Node* node, bool& hasReal, bool& hasInteger) {
-    if (!node) return false;
+            bool real = left.type == TT_REAL || right.type == TT_REAL;
+            if (real && left.type == TT_INTEGER) convertAfter[right.start - 1] = true;
+            if (real && right.type == TT_INTEGER) convertAfter[i - 1] = true;
 
-    if (node->name == "REAL") {
-        hasReal = true;
-    }
-    else if (node->name == "INTEGER") {
-        hasInteger = true;
-    }
-    else if (node->name == "IDENTIFIER") {
-        VarInfo* symbol = findVar(node->value);
-        if (symbol) {
-            if (symbol->type == TT_REAL) {
-                hasReal = true;
+            items[i] = std::string(left.size != 0 ? "V" : "") + (item == "+" ? "ADD" : "SUB") + (real ? "_R" : "_I");
+            left.type = real ? TT_REAL : TT_INTEGER;
+        }
+        else {
+            TokenType type = TT_UNKNOWN;
+            int elements = 0;
+            if (!item.empty() && std::isdigit((unsigned char)item[0])) {
+                type = item.find('.') != std::string::npos ? TT_REAL : TT_INTEGER;
             }
-            else if (symbol->type == TT_INTEGER) {
-                hasInteger = true;
+            else if (VarInfo* var = findVar(item)) {
+                type = var->type;
+                elements = var->size;
             }
+            stack.push_back(Operand{ type, i, elements });
         }
     }
+    if (stack.size() != 1) return TT_UNKNOWN;
 
-    for (auto child : node->children) {
-        checkExpressionTypes(child, hasReal, hasInteger);
+    std::vector<std::string> typed;
+    typed.reserve(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        typed.push_back(items[i]);
+        if (convertAfter[i]) typed.push_back("I2R");
     }
-
-    return hasReal && hasInteger;
+    items.swap(typed);
+    size = stack[0].size;
+    return stack[0].type;
 }
 
 //   
@@ -376,8 +609,8 @@ void SemanticAnalyzer::convertToPostfix(Node* node, std::vector<std::string>& ou
     }
 }
 
-void SemanticAnalyzer::expressionToPostfix(Node* exprNode, std::string& result) {
-    if (!exprNode) return;
+TokenType SemanticAnalyzer::expressionToPostfix(Node* exprNode, std::string& result, int& size) {
+    if (!exprNode) return TT_UNKNOWN;
 
     std::vector<std::string> outputVec;
     std::stack<std::string> operators;
@@ -387,28 +620,27 @@ void SemanticAnalyzer::expressionToPostfix(Node* exprNode, std::string& result)
         outputVec.push_back(operators.top());
         operators.pop();
     }
+    TokenType type = typePostfix(outputVec, size);
 
     for (size_t i = 0; i < outputVec.size(); i++) {
         if (i > 0) result += " ";
         result += outputVec[i];
     }
+    return type;
 }
 
 void SemanticAnalyzer::processEnd(Node* node) {
-    std::string endName;
-    int line = -1;
+    Node* endNode = nullptr;
 
     for (auto child : node->children) {
         if (child->name == "IDENTIFIER") {
-            endName = child->value;
-            line = child->lineNumber;
+            endNode = child;
         }
     }
 
-    if (!endName.empty()) {
-        checkProgramNameMatch(endName, line);
-        std::string Postfix = endName + " END";
-        postfixCode.push_back(Postfix);
-        output << Postfix << "\n";
+    if (endNode && !endNode->value.empty()) {
+        checkProgramNameMatch(endNode->value, endNode->lineNumber);
+        std::string Postfix = endNode->value + " END";
+        emit(Postfix, endNode->lineNumber);
     }
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 #include "Token.h"
 #include "Synt.h"
+#include "Diagnostic.h"
 #include "HashTable.h"
+#include "ConstantFolder.h"
+#include "ExpressionDag.h"
+#include "Reassociate.h"
+#include "Cancel.h"
 #include <vector>
 #include <string>
 #include <stack>
@@ -9,14 +14,17 @@
 #include <iostream>
 #include <algorithm>
 
+//    
+const int MAX_ARRAY_SIZE = 1 << 24;
+
 struct VarInfo {
     std::string name;
     TokenType type;
-    bool initialized;
+    int size;           //  , 0 -  
 
-    VarInfo() : name(""), type(TT_UNKNOWN), initialized(false) {}
-    VarInfo(const std::string& n, TokenType t, bool init = false)
-        : name(n), type(t), initialized(init) {
+    VarInfo() : name(""), type(TT_UNKNOWN), size(0) {}
+    VarInfo(const std::string& n, TokenType t, int elements = 0)
+        : name(n), type(t), size(elements) {
     }
 
     std::string getKey() const { return name; }
@@ -33,19 +41,31 @@ struct VarInfo {
 class SemanticAnalyzer {
 private:
     Node* astRoot;
-    std::ofstream& output;
-    std::vector<std::string> errors;
+    std::ostream& output;
+    std::vector<Diagnostic> errors;
+    ErrorBudget* budget;                //   , nullptr -  
+    bool stopped;                       //  ,  
+    CancelPoll cancelPoll;
+    std::vector<std::string> warnings;
     std::vector<std::string> postfixCode;
+    std::vector<int> postfixLines;      //      
 
     HashTable<VarInfo> varTable;
+    size_t symbolLookups;               //   
 
     std::string programName;
 
+    bool optimize;                      //       
+    ConstantFolder folder;
+    Reassociator reassociator;
+    ExpressionDag dag;
+
     //  
     void processDescriptionsNode(Node* node);
     void processOperatorsNode(Node* node);
     void processEndNode(Node* node);
     void processOpNode(Node* node);
+    void processDescr(Node* node, TokenType& currentType);
 
     //  
     void processBegin(Node* node);
@@ -54,18 +74,22 @@ private:
     void processCall(Node* callNode);
     void processEnd(Node* node);
 
-    //  
-    TokenType analyzeExpression(Node* exprNode, std::string& postfix);
+    //  ; size -   , 0 - , -1 -    
+    TokenType analyzeExpression(Node* exprNode, std::string& postfix, int& size);
 
     //
     void checkVariableDeclared(const std::string& varName, int line);
     void checkVariableNotRedeclared(const std::string& varName, int line);
     void checkTypeCompatibility(TokenType leftType, TokenType rightType, int line);
     void checkProgramNameMatch(const std::string& endName, int line);
-    bool checkExpressionTypes(Node* node, bool& hasReal, bool& hasInteger);
+    void report(const Diagnostic& diagnostic);
+    bool interrupted();
+    std::string formatError(const Diagnostic& diagnostic) const;
 
     // 
-    void expressionToPostfix(Node* exprNode, std::string& result);
+    void emit(const std::string& code, int line);
+    TokenType expressionToPostfix(Node* exprNode, std::string& result, int& size);
+    TokenType typePostfix(std::vector<std::string>& items, int& size);
 
     VarInfo* findVar(const std::string& name);
 
@@ -75,7 +99,29 @@ private:
         std::stack<std::string>& operators);
 
 public:
-    SemanticAnalyzer(Node* root, std::ofstream& outputStream);
+    SemanticAnalyzer(Node* root, std::ostream& outputStream);
     void analyze();
-    std::vector<std::string> getErrors() const { return errors; }
+    void setOptimize(bool enabled) { optimize = enabled; }
+    void setFastMath(bool enabled) { reassociator.setFastMath(enabled); }
+    void setConstants(ConstantPool* constants) { folder.setConstants(constants); }
+    void setErrorBudget(ErrorBudget* errorBudget) { budget = errorBudget; }
+    bool isStopped() const { return stopped; }
+    //       ;   
+    void setCancel(const CancelToken* token) { cancelPoll.setToken(token); }
+    bool isCancelled() const { return cancelPoll.isStopped(); }
+    std::vector<std::string> getErrors() const;
+    size_t getErrorCount() const { return errors.size(); }
+    size_t getSymbolLookups() const { return symbolLookups; }
+    //       symbolLookups, nullptr -  
+    const VarInfo* getVariable(const std::string& name) const { return varTable.getValue(varTable.findIndex(name)); }
+    const std::vector<std::string>& getWarnings() const { return warnings; }
+    const ExpressionDag& getExpressionDag() const { return dag; }
+    const Reassociator& getReassociator() const { return reassociator; }
+    const std::vector<std::string>& getPostfixCode() const { return postfixCode; }
+    const std::vector<int>& getPostfixLines() const { return postfixLines; }
+
+    //     :
+    //        
+    void analyzeStatement(Node* stmt, std::vector<std::string>& stmtPostfix,
+        std::vector<std::string>& stmtErrors);
 };
\ No newline at end of file
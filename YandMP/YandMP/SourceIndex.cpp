@@ -0,0 +1,110 @@
+#include "SourceIndex.h"
+#include <algorithm>
+#include <utility>
+
+void SourceIndex::build(std::vector<Token> tokenList, std::vector<size_t> lineStartList, const Node* tree) {
+    tokens = std::move(tokenList);
+    lineStarts = std::move(lineStartList);
+    if (lineStarts.empty()) lineStarts.push_back(0);
+
+    std::vector<std::pair<std::string, SymbolReference>> found;
+    if (tree) collect(tree, found);
+
+    // -   ;      
+    std::sort(found.begin(), found.end(), [](const std::pair<std::string, SymbolReference>& a,
+        const std::pair<std::string, SymbolReference>& b) {
+        if (a.second.kind != b.second.kind) return a.second.kind < b.second.kind;
+        if (a.first != b.first) return a.first < b.first;
+        return a.second.offset < b.second.offset;
+    });
+
+    bySymbol.clear();
+    symbolStarts.clear();
+    symbolNames.clear();
+    for (size_t i = 0; i < found.size(); i++) {
+        if (i == 0 || found[i].second.kind != found[i - 1].second.kind || found[i].first != found[i - 1].first) {
+            symbolStarts.push_back(bySymbol.size());
+            symbolNames.push_back(found[i].first);
+        }
+        found[i].second.symbol = (int)symbolNames.size() - 1;
+        bySymbol.push_back(found[i].second);
+    }
+    symbolStarts.push_back(bySymbol.size());
+
+    byOffset = bySymbol;
+    std::sort(byOffset.begin(), byOffset.end(), [](const SymbolReference& a, const SymbolReference& b) {
+        return a.offset < b.offset;
+    });
+}
+
+//  Begin   ,  End   ;
+// VarList -  ,  CALL -  ,    - 
+void SourceIndex::collect(const Node* node, std::vector<std::pair<std::string, SymbolReference>>& found) const {
+    for (size_t i = 0; i < node->children.size(); i++) {
+        const Node* child = node->children[i];
+        if (child->name != "IDENTIFIER") {
+            collect(child, found);
+            continue;
+        }
+        if (child->offset == std::string::npos) continue;
+
+        SymbolReference reference;
+        reference.offset = child->offset;
+        reference.length = child->value.size();
+        reference.line = (int)(std::upper_bound(lineStarts.begin(), lineStarts.end(), child->offset) - lineStarts.begin());
+        reference.column = (int)(child->offset - lineStarts[reference.line - 1]) + 1;
+        reference.symbol = -1;
+        if (node->name == "Begin" || node->name == "End") {
+            reference.kind = NAME_PROGRAM;
+        }
+        else if (node->name == "Op" && i > 0 && node->children[i - 1]->value == "CALL") {
+            reference.kind = NAME_PROCEDURE;
+        }
+        else {
+            reference.kind = NAME_VARIABLE;
+        }
+        reference.declaration = node->name == "Begin" || node->name == "VarList";
+        found.emplace_back(child->value, reference);
+    }
+}
+
+size_t SourceIndex::toOffset(int line, int column) const {
+    if (line < 1 || (size_t)line > lineStarts.size() || column < 1) return std::string::npos;
+    size_t offset = lineStarts[line - 1] + (size_t)(column - 1);
+    if ((size_t)line < lineStarts.size() && offset >= lineStarts[line]) return std::string::npos;
+    return offset;
+}
+
+const Token* SourceIndex::tokenAt(size_t offset) const {
+    auto next = std::upper_bound(tokens.begin(), tokens.end(), offset, [](size_t value, const Token& token) {
+        return value < token.getOffset();
+    });
+    if (next == tokens.begin()) return nullptr;
+    const Token& token = *(next - 1);
+    return offset < token.getOffset() + token.getLexeme().size() ? &token : nullptr;
+}
+
+const SymbolReference* SourceIndex::referenceAt(size_t offset) const {
+    auto next = std::upper_bound(byOffset.begin(), byOffset.end(), offset, [](size_t value, const SymbolReference& reference) {
+        return value < reference.offset;
+    });
+    if (next == byOffset.begin()) return nullptr;
+    const SymbolReference& reference = *(next - 1);
+    return offset < reference.offset + reference.length ? &reference : nullptr;
+}
+
+//  -  ,   
+const SymbolReference* SourceIndex::declarationOf(const SymbolReference& reference) const {
+    for (size_t i = symbolStarts[reference.symbol]; i < symbolStarts[reference.symbol + 1]; i++) {
+        if (bySymbol[i].declaration) return &bySymbol[i];
+    }
+    return nullptr;
+}
+
+std::vector<const SymbolReference*> SourceIndex::referencesOf(const SymbolReference& reference) const {
+    std::vector<const SymbolReference*> result;
+    for (size_t i = symbolStarts[reference.symbol]; i < symbolStarts[reference.symbol + 1]; i++) {
+        result.push_back(&bySymbol[i]);
+    }
+    return result;
+}
\ No newline at end of file
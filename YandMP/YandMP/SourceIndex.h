@@ -0,0 +1,59 @@
+#pragma once
+#include "Token.h"
+#include "Synt.h"
+#include <string>
+#include <vector>
+
+// :       ,   CALL - 
+enum NameKind {
+    NAME_PROGRAM,
+    NAME_VARIABLE,
+    NAME_PROCEDURE
+};
+
+//    
+struct SymbolReference {
+    size_t offset;
+    size_t length;
+    int line;
+    int column;
+    NameKind kind;
+    int symbol;             //   SourceIndex
+    bool declaration;
+};
+
+//      .    
+//  ,     ,   
+// ,     -     
+class SourceIndex {
+public:
+    //tokenList -     , lineStartList - Lexer::getLineStarts(),
+    //     IDENTIFIER 
+    void build(std::vector<Token> tokenList, std::vector<size_t> lineStartList, const Node* tree);
+
+    //  line:column ( 1), npos -  
+    size_t toOffset(int line, int column) const;
+
+    //   ,  ; nullptr -    
+    const Token* tokenAt(size_t offset) const;
+    const SymbolReference* referenceAt(size_t offset) const;
+
+    //  , nullptr -   
+    const SymbolReference* declarationOf(const SymbolReference& reference) const;
+    //     
+    std::vector<const SymbolReference*> referencesOf(const SymbolReference& reference) const;
+    const std::string& symbolName(const SymbolReference& reference) const { return symbolNames[reference.symbol]; }
+
+    size_t getTokenCount() const { return tokens.size(); }
+    size_t getReferenceCount() const { return byOffset.size(); }
+
+private:
+    std::vector<Token> tokens;
+    std::vector<size_t> lineStarts;
+    std::vector<SymbolReference> byOffset;
+    std::vector<SymbolReference> bySymbol;  //   ,  -  
+    std::vector<size_t> symbolStarts;       //    bySymbol,   - 
+    std::vector<std::string> symbolNames;
+
+    void collect(const Node* node, std::vector<std::pair<std::string, SymbolReference>>& found) const;
+};
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "Stats.h"
+#include "Memory.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static double wallSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Windows clock()   ,      
+static double cpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (double)(k.QuadPart + u.QuadPart) / 1e7;
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+CompileStats::CompileStats()
+    : symbolLookups(0), lexicalErrors(0), syntaxErrors(0), semanticErrors(0), warnings(0),
+    optimized(false), sharedUses(0), dagNodes(0), temporaries(0), reassociatedChains(0), depthBefore(0), depthAfter(0),
+    bytesWritten(0) {
+    for (auto& phase : phases) phase = PhaseTime{ 0, 0, 0, 0 };
+    for (auto& count : tokens) count = 0;
+}
+
+const char* CompileStats::phaseName(int phase) {
+    switch (phase) {
+    case PHASE_LEXER: return "lexer";
+    case PHASE_PARSER: return "parser";
+    case PHASE_SEMANTIC: return "semantic";
+    default: return "output";
+    }
+}
+
+void CompileStats::begin(Phase phase) {
+    phases[phase].wallStart = wallSeconds();
+    phases[phase].cpuStart = cpuSeconds();
+    if (MemoryTracker::isEnabled()) MemoryTracker::beginPhase(phase);
+}
+
+void CompileStats::end(Phase phase) {
+    if (MemoryTracker::isEnabled()) MemoryTracker::endPhase();
+    phases[phase].wall += wallSeconds() - phases[phase].wallStart;
+    phases[phase].cpu += cpuSeconds() - phases[phase].cpuStart;
+}
+
+void CompileStats::countTokens(const std::vector<Token>& tokenList) {
+    for (const auto& token : tokenList) {
+        tokens[token.getType()]++;
+    }
+}
+
+void CompileStats::countNodes(const Node* node) {
+    if (!node) return;
+    nodes[node->name]++;
+    for (auto child : node->children) {
+        countNodes(child);
+    }
+}
+
+void CompileStats::setDiagnostics(size_t lexical, size_t syntax, size_t semantic, size_t warning) {
+    lexicalErrors = lexical;
+    syntaxErrors = syntax;
+    semanticErrors = semantic;
+    warnings = warning;
+}
+
+void CompileStats::setCommonSubexpressions(size_t shared, size_t nodeCount, size_t temporaryCount) {
+    optimized = true;
+    sharedUses = shared;
+    dagNodes = nodeCount;
+    temporaries = temporaryCount;
+}
+
+void CompileStats::setReassociation(size_t chains, int before, int after) {
+    optimized = true;
+    reassociatedChains = chains;
+    depthBefore = before;
+    depthAfter = after;
+}
+
+void CompileStats::addOutputFile(const std::string& path) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if (!error) bytesWritten += (size_t)size;
+}
+
+void CompileStats::printSummary(std::ostream& out) const {
+    out << "Phase         wall ms     cpu ms\n";
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        char line[64];
+        std::snprintf(line, sizeof(line), "%-10s %10.3f %10.3f\n", phaseName(p), phases[p].wall * 1000, phases[p].cpu * 1000);
+        out << line;
+    }
+
+    out << "Tokens:";
+    for (int t = 0; t <= TT_ERROR; t++) {
+        if (tokens[t] > 0) out << " " << Token("", (TokenType)t).typeToString() << "=" << tokens[t];
+    }
+    out << "\nNodes:";
+    for (const auto& node : nodes) {
+        out << " " << node.first << "=" << node.second;
+    }
+    out << "\nSymbol table lookups: " << symbolLookups << "\n";
+    out << "Diagnostics: lexical=" << lexicalErrors << " syntax=" << syntaxErrors
+        << " semantic=" << semanticErrors << " warnings=" << warnings << "\n";
+    if (optimized) {
+        out << "Common subexpressions: " << sharedUses << " shared uses of " << dagNodes << " DAG nodes, "
+            << temporaries << " temporaries\n";
+        out << "Reassociated chains: " << reassociatedChains << ", expression depth "
+            << depthBefore << " -> " << depthAfter << "\n";
+    }
+    out << "Bytes written: " << bytesWritten << "\n";
+
+    if (MemoryTracker::isEnabled()) {
+        out << "Phase       allocations      bytes   peak live\n";
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            MemoryTracker::PhaseMemory memory = MemoryTracker::getPhase(p);
+            char line[96];
+            std::snprintf(line, sizeof(line), "%-10s %12zu %10zu %11zu\n", phaseName(p),
+                memory.allocations, memory.bytes, memory.peak);
+            out << line;
+        }
+        out << "Peak live bytes: " << MemoryTracker::getPeakBytes() << "\n";
+    }
+    out << "Peak RSS: " << MemoryTracker::getPeakRss() << " bytes\n";
+}
+
+void CompileStats::printJson(std::ostream& out) const {
+    out << "{\"phases\":{";
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        char line[128];
+        std::snprintf(line, sizeof(line), "%s\"%s\":{\"wall_ms\":%.3f,\"cpu_ms\":%.3f}",
+            p ? "," : "", phaseName(p), phases[p].wall * 1000, phases[p].cpu * 1000);
+        out << line;
+    }
+
+    out << "},\"tokens\":{";
+    bool first = true;
+    for (int t = 0; t <= TT_ERROR; t++) {
+        if (tokens[t] == 0) continue;
+        out << (first ? "" : ",") << "\"" << Token("", (TokenType)t).typeToString() << "\":" << tokens[t];
+        first = false;
+    }
+
+    out << "},\"nodes\":{";
+    first = true;
+    for (const auto& node : nodes) {
+        out << (first ? "" : ",") << "\"" << node.first << "\":" << node.second;
+        first = false;
+    }
+
+    out << "},\"symbol_lookups\":" << symbolLookups
+        << ",\"diagnostics\":{\"lexical\":" << lexicalErrors << ",\"syntax\":" << syntaxErrors
+        << ",\"semantic\":" << semanticErrors << ",\"warnings\":" << warnings << "}";
+    if (optimized) {
+        out << ",\"common_subexpressions\":{\"shared_uses\":" << sharedUses << ",\"dag_nodes\":" << dagNodes
+            << ",\"temporaries\":" << temporaries << "}";
+        out << ",\"reassociation\":{\"chains\":" << reassociatedChains << ",\"depth_before\":" << depthBefore
+            << ",\"depth_after\":" << depthAfter << "}";
+    }
+    out << ",\"bytes_written\":" << bytesWritten;
+
+    if (MemoryTracker::isEnabled()) {
+        out << ",\"memory\":{";
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            MemoryTracker::PhaseMemory memory = MemoryTracker::getPhase(p);
+            out << "\"" << phaseName(p) << "\":{\"allocations\":" << memory.allocations
+                << ",\"bytes\":" << memory.bytes << ",\"peak_live\":" << memory.peak << "},";
+        }
+        out << "\"peak_live\":" << MemoryTracker::getPeakBytes() << ",\"budget\":" << MemoryTracker::getBudget() << "}";
+    }
+    out << ",\"peak_rss\":" << MemoryTracker::getPeakRss() << "}\n";
+}
\ No newline at end of file
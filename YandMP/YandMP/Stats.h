@@ -0,0 +1,59 @@
+#pragma once
+#include "Token.h"
+#include "Synt.h"
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//    (--stats, --stats-json).   compileFile,
+//   CompileFiles  ;    
+class CompileStats {
+public:
+    enum Phase { PHASE_LEXER, PHASE_PARSER, PHASE_SEMANTIC, PHASE_OUTPUT, PHASE_COUNT };
+
+    CompileStats();
+
+    void begin(Phase phase);
+    void end(Phase phase);
+
+    void countTokens(const std::vector<Token>& tokens);
+    void countNodes(const Node* node);
+    void setSymbolLookups(size_t count) { symbolLookups = count; }
+    void setDiagnostics(size_t lexical, size_t syntax, size_t semantic, size_t warning);
+    //    (-O);      
+    void setCommonSubexpressions(size_t shared, size_t nodeCount, size_t temporaryCount);
+    //          (-O)
+    void setReassociation(size_t chains, int before, int after);
+    void addOutputFile(const std::string& path);
+
+    void printSummary(std::ostream& out) const;
+    void printJson(std::ostream& out) const;
+
+private:
+    struct PhaseTime {
+        double wall;        //
+        double cpu;         //  , 
+        double wallStart;
+        double cpuStart;
+    };
+
+    PhaseTime phases[PHASE_COUNT];
+    size_t tokens[TT_ERROR + 1];                // TokenType
+    std::map<std::string, size_t> nodes;        //   
+    size_t symbolLookups;
+    size_t lexicalErrors;
+    size_t syntaxErrors;
+    size_t semanticErrors;
+    size_t warnings;
+    bool optimized;
+    size_t sharedUses;
+    size_t dagNodes;
+    size_t temporaries;
+    size_t reassociatedChains;
+    int depthBefore;
+    int depthAfter;
+    size_t bytesWritten;
+
+    static const char* phaseName(int phase);
+};
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include "Synt.h"
+#include "Trace.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 
-Synt::Synt(const std::vector<Token>& tokenList, std::ofstream& output)
+Synt::Synt(const std::vector<Token>& tokenList, std::ostream& output)
     : tokens(tokenList), currentTokenIndex(0), astOutput(output),
-    indentLevel(0), lineNumber(0), inDescriptionsSection(true), root(nullptr) {
+    indentLevel(0), lineNumber(0), budget(nullptr), stopped(false), inDescriptionsSection(true), root(nullptr) {
 }
 
 void Synt::printNumberedLine(const std::string& line) {
@@ -71,31 +72,71 @@ bool Synt::matchKeyword(const std::string& keyword) {
     return false;
 }
 
-//  
-void Synt::error(const std::string& message) {
-    std::stringstream ss;
+//     -      (SourceIndex.h)
+Node* Synt::identifierNode(const Token& token) {
+    auto node = new Node("IDENTIFIER", token.getLexeme(), token.getLine());
+    node->offset = token.getOffset();
+    return node;
+}
+
+//  :     ,  -  
+void Synt::error(DiagCode code) {
+    if (stopped) return;
+    if (budget && !budget->reserve()) {
+        // :     
+        stopped = true;
+        currentTokenIndex = tokens.size();
+        return;
+    }
 
+    int token = (int)currentTokenIndex;
+    int line = -1;
     if (currentTokenIndex < tokens.size()) {
-        Token token = currentToken();
-        ss << "SYNTAX ERROR at line " << token.getLine()
-            << " (token: '" << token.getLexeme() << "'): " << message;
+        line = tokens[currentTokenIndex].getLine();
     }
-    else {
+    else if (!tokens.empty()) {
         //  
-        if (!tokens.empty()) {
-            Token lastToken = tokens.back();
-            ss << "SYNTAX ERROR at line " << lastToken.getLine()
-                << ": " << message << " (unexpected end of file)";
-        }
-        else {
-            ss << "SYNTAX ERROR: " << message << " (file is empty)";
-        }
+        token = DIAG_AT_EOF;
+        line = tokens.back().getLine();
     }
+    else {
+        token = DIAG_EMPTY_FILE;
+    }
+    errors.push_back(Diagnostic{ code, line, token, "", TT_UNKNOWN, TT_UNKNOWN });
 
-    errors.push_back(ss.str());
+    if (budget && budget->isSpent()) {
+        //   :    
+        stopped = true;
+        currentTokenIndex = tokens.size();
+        return;
+    }
     syncAfterError();
 }
 
+//   :   ,    
+bool Synt::pollCancel() {
+    if (!cancelPoll.poll()) return false;
+    stopped = true;
+    currentTokenIndex = tokens.size();
+    return true;
+}
+
+std::string Synt::formatError(const Diagnostic& diagnostic) const {
+    std::string message = diagnosticMessage(diagnostic.code);
+
+    if (diagnostic.token >= 0) {
+        const std::string lexeme = tokens[diagnostic.token].getLexeme();
+        if (diagnostic.code == DIAG_UNEXPECTED_AFTER_END) {
+            message = "Unexpected token(s) '" + lexeme + "' after END";
+        }
+        return "SYNTAX ERROR at line " + std::to_string(diagnostic.line) + " (token: '" + lexeme + "'): " + message;
+    }
+    if (diagnostic.token == DIAG_AT_EOF) {
+        return "SYNTAX ERROR at line " + std::to_string(diagnostic.line) + ": " + message + " (unexpected end of file)";
+    }
+    return "SYNTAX ERROR: " + message + " (file is empty)";
+}
+
 //  
 void Synt::syncAfterError() {
     //  
@@ -193,19 +234,69 @@ void Synt::syncToNextArgument() {
 
 
 void Synt::synt() {
+    TraceSpan span("Synt::synt");
+    if (budget && budget->isSpent()) {
+        //     
+        stopped = true;
+        astOutput << "Parsing skipped: error limit reached\n";
+        return;
+    }
     root = parseProgram();
 
-    if (!errors.empty()) {
-        for (const auto& errorMsg : errors) {
-            astOutput << errorMsg << "\n";
+    if (cancelPoll.isStopped()) {
+        astOutput << "Parsing cancelled\n";
+    }
+    else if (!errors.empty()) {
+        for (const auto& diagnostic : errors) {
+            astOutput << formatError(diagnostic) << "\n";
+        }
+        if (stopped) {
+            astOutput << "Parsing stopped after " << errors.size() << " error(s)\n";
         }
-        astOutput << "Parsing completed with " << errors.size() << " error(s)\n";
+        else {
+            astOutput << "Parsing completed with " << errors.size() << " error(s)\n";
+        }
+    }
+    else if (stopped) {
+        //   ,   
+        astOutput << "Parsing stopped: error limit reached\n";
     }
     else {
         astOutput << "Parsing completed successfully!\n";
     }
 }
 
+//      ,     
+Node* Synt::parseStatement() {
+    Token token = currentToken();
+
+    if (token.getType() == TT_KEYWORD) {
+        if (token.getLexeme() == "PROGRAM") {
+            indentLevel = 1;
+            return parseBegin();
+        }
+        if (token.getLexeme() == "INTEGER" || token.getLexeme() == "REAL") {
+            indentLevel = 2;
+            return parseDescr();
+        }
+        if (token.getLexeme() == "CALL") {
+            indentLevel = 2;
+            return parseOp();
+        }
+        if (token.getLexeme() == "END") {
+            indentLevel = 1;
+            return parseEnd();
+        }
+    }
+    else if (token.getType() == TT_IDENTIFIER) {
+        indentLevel = 2;
+        return parseOp();
+    }
+
+    error(DIAG_EXPECTED_STATEMENT);
+    return nullptr;
+}
+
 //  Program
 Node* Synt::parseProgram() {
     auto node = new Node("Program");
@@ -235,16 +326,12 @@ Node* Synt::parseProgram() {
         node->addChild(endNode);
     }
     else {
-        error("Expected END statement");
+        error(DIAG_EXPECTED_END_STATEMENT);
     }
 
     //     ( END)
     if (currentTokenIndex < tokens.size()) {
-        Token unexpected = currentToken();
-        std::stringstream errorMsg;
-        errorMsg << "Unexpected token(s) '" << unexpected.getLexeme()
-            << "' after END";
-        error(errorMsg.str());
+        error(DIAG_UNEXPECTED_AFTER_END);
     }
 
     decreaseIndent();
@@ -263,12 +350,12 @@ Node* Synt::parseBegin() {
         printLeaf("PROGRAM");
 
         if (match(TT_IDENTIFIER)) {
-            auto idNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+            auto idNode = identifierNode(tokens[currentTokenIndex - 1]);
             node->addChild(idNode);
             printLeaf(tokens[currentTokenIndex - 1].getLexeme());
         }
         else {
-            error("Expected identifier after PROGRAM");
+            error(DIAG_EXPECTED_PROGRAM_ID);
             //      
             while (currentTokenIndex < tokens.size()) {
                 Token token = currentToken();
@@ -282,12 +369,12 @@ Node* Synt::parseBegin() {
         }
     }
     else {
-        error("Expected 'PROGRAM'");
+        error(DIAG_EXPECTED_PROGRAM);
         // -   
         while (currentTokenIndex < tokens.size()) {
             if (currentToken().getType() == TT_IDENTIFIER) {
                 //   
-                auto idNode = new Node("IDENTIFIER", tokens[currentTokenIndex].getLexeme(), tokens[currentTokenIndex].getLine());
+                auto idNode = identifierNode(tokens[currentTokenIndex]);
                 node->addChild(idNode);
                 printLeaf(tokens[currentTokenIndex].getLexeme());
                 nextToken();
@@ -303,6 +390,7 @@ Node* Synt::parseBegin() {
 
 //  
 Node* Synt::parseDescriptions() {
+    TraceSpan span("Synt::parseDescriptions", TRACE_PASSES);
     auto node = new Node("Descriptions");
     printNode("Descriptions");
     increaseIndent();
@@ -311,6 +399,7 @@ Node* Synt::parseDescriptions() {
     while (currentTokenIndex < tokens.size() &&
         currentToken().getType() == TT_KEYWORD &&
         (currentToken().getLexeme() == "INTEGER" || currentToken().getLexeme() == "REAL")) {
+        if (pollCancel()) break;
         auto descrNode = parseDescr();
         if (descrNode) {
             node->addChild(descrNode);
@@ -323,6 +412,7 @@ Node* Synt::parseDescriptions() {
 
 //Descr -> Type VarList
 Node* Synt::parseDescr() {
+    TraceSpan span("Synt::parseDescr", TRACE_STATEMENTS, currentToken().getLine());
     auto node = new Node("Descr");
     printNode("Descr");
     increaseIndent();
@@ -358,23 +448,25 @@ Node* Synt::parseType() {
         printLeaf("REAL");
     }
     else {
-        error("Expected 'INTEGER' or 'REAL'");
+        error(DIAG_EXPECTED_TYPE);
     }
 
     decreaseIndent();
     return node;
 }
 
-//VarList -> Id | Id , VarList
+//VarList -> Var | Var , VarList
+//Var -> Id | Id ( Const )
 Node* Synt::parseVarList() {
     auto node = new Node("VarList");
     printNode("VarList");
     increaseIndent();
 
     if (match(TT_IDENTIFIER)) {
-        auto idNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+        auto idNode = identifierNode(tokens[currentTokenIndex - 1]);
         node->addChild(idNode);
         printLeaf(tokens[currentTokenIndex - 1].getLexeme());
+        parseArraySize(node);
 
         while (match(TT_COMMA)) {
             auto commaNode = new Node("COMMA", ",", tokens[currentTokenIndex - 1].getLine());
@@ -382,26 +474,51 @@ Node* Synt::parseVarList() {
             printLeaf(",");
 
             if (match(TT_IDENTIFIER)) {
-                auto nextIdNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+                auto nextIdNode = identifierNode(tokens[currentTokenIndex - 1]);
                 node->addChild(nextIdNode);
                 printLeaf(tokens[currentTokenIndex - 1].getLexeme());
+                parseArraySize(node);
             }
             else {
-                error("Expected identifier after comma");
+                error(DIAG_EXPECTED_ID_AFTER_COMMA);
                 break;
             }
         }
     }
     else {
-        error("Expected identifier in variable list");
+        error(DIAG_EXPECTED_ID_IN_LIST);
     }
 
     decreaseIndent();
     return node;
 }
 
+//     :  ( Const )   VarList   IDENTIFIER
+void Synt::parseArraySize(Node* varList) {
+    if (!match(TT_LPAREN)) return;
+    varList->addChild(new Node("LPAREN", "(", tokens[currentTokenIndex - 1].getLine()));
+    printLeaf("(");
+
+    if (match(TT_INTEGER)) {
+        varList->addChild(new Node("INTEGER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine()));
+        printLeaf(tokens[currentTokenIndex - 1].getLexeme());
+    }
+    else {
+        error(DIAG_EXPECTED_ARRAY_SIZE);
+    }
+
+    if (match(TT_RPAREN)) {
+        varList->addChild(new Node("RPAREN", ")", tokens[currentTokenIndex - 1].getLine()));
+        printLeaf(")");
+    }
+    else {
+        error(DIAG_EXPECTED_RPAREN_SIZE);
+    }
+}
+
 //  
 Node* Synt::parseOperators() {
+    TraceSpan span("Synt::parseOperators", TRACE_PASSES);
     auto node = new Node("Operators");
     printNode("Operators");
     increaseIndent();
@@ -411,6 +528,7 @@ Node* Synt::parseOperators() {
         !(currentToken().getType() == TT_KEYWORD && currentToken().getLexeme() == "END") &&
         (currentToken().getType() == TT_IDENTIFIER ||
             (currentToken().getType() == TT_KEYWORD && currentToken().getLexeme() == "CALL"))) {
+        if (pollCancel()) break;
         auto opNode = parseOp();
         if (opNode) {
             node->addChild(opNode);
@@ -423,6 +541,7 @@ Node* Synt::parseOperators() {
 
 //Op -> Id = Expr | CALL Id ( VarList )
 Node* Synt::parseOp() {
+    TraceSpan span("Synt::parseOp", TRACE_STATEMENTS, currentToken().getLine());
     auto node = new Node("Op");
     printNode("Op");
     increaseIndent();
@@ -430,7 +549,7 @@ Node* Synt::parseOp() {
     if (currentToken().getType() == TT_IDENTIFIER) {
         // : Id = Expr
         std::string identifier = currentToken().getLexeme();
-        auto idNode = new Node("IDENTIFIER", identifier, currentToken().getLine());
+        auto idNode = identifierNode(currentToken());
         node->addChild(idNode);
         nextToken();
         printLeaf(identifier);
@@ -452,12 +571,12 @@ Node* Synt::parseOp() {
             //    ,    = 
             if (currentTokenIndex < tokens.size() &&
                 currentToken().getType() == TT_ASSIGN) {
-                error("Unexpected '=' after expression");
+                error(DIAG_UNEXPECTED_ASSIGN);
                 syncToNextOperator();
             }
         }
         else {
-            error("Expected '=' in assignment");
+            error(DIAG_EXPECTED_ASSIGN);
             syncToNextOperator();
         }
     }
@@ -469,7 +588,7 @@ Node* Synt::parseOp() {
         nextToken();
 
         if (match(TT_IDENTIFIER)) {
-            auto procNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+            auto procNode = identifierNode(tokens[currentTokenIndex - 1]);
             node->addChild(procNode);
             printLeaf(tokens[currentTokenIndex - 1].getLexeme());
 
@@ -489,17 +608,17 @@ Node* Synt::parseOp() {
                     printLeaf(")");
                 }
                 else {
-                    error("Expected ')' after arguments");
+                    error(DIAG_EXPECTED_RPAREN_ARGS);
                     syncToNextOperator();
                 }
             }
             else {
-                error("Expected '(' after CALL identifier");
+                error(DIAG_EXPECTED_LPAREN);
                 syncToNextOperator();
             }
         }
         else {
-            error("Expected identifier after CALL");
+            error(DIAG_EXPECTED_CALL_ID);
             syncToNextOperator();
         }
     }
@@ -576,7 +695,8 @@ Node* Synt::parseExpr() {
                 break;
             }
 
-            if (currentTokenIndex >= tokens.size()) break;
+            //     
+            if (pollCancel() || currentTokenIndex >= tokens.size()) break;
             opType = currentToken().getType();
         }
     }
@@ -592,10 +712,10 @@ Node* Synt::parseSimpleExpr() {
     increaseIndent();
 
     if (currentTokenIndex >= tokens.size()) {
-        error("Unexpected end of input in expression");
+        error(DIAG_UNEXPECTED_EOF_EXPR);
     }
     else if (match(TT_IDENTIFIER)) {
-        auto idNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+        auto idNode = identifierNode(tokens[currentTokenIndex - 1]);
         node->addChild(idNode);
         printLeaf(tokens[currentTokenIndex - 1].getLexeme());
     }
@@ -625,7 +745,7 @@ Node* Synt::parseSimpleExpr() {
             printLeaf(")");
         }
         else {
-            error("Expected ')' after expression");
+            error(DIAG_EXPECTED_RPAREN_EXPR);
             syncToEndOfExpression();
         }
     }
@@ -633,10 +753,10 @@ Node* Synt::parseSimpleExpr() {
         Token token = currentToken();
         if (token.getType() == TT_PLUS || token.getType() == TT_MINUS ||
             token.getType() == TT_RPAREN || token.getType() == TT_COMMA) {
-            error("Missing operand in expression");
+            error(DIAG_MISSING_OPERAND);
         }
         else {
-            error("Expected identifier, constant, or '('");
+            error(DIAG_EXPECTED_OPERAND);
         }
         syncToEndOfExpression();
     }
@@ -656,16 +776,16 @@ Node* Synt::parseEnd() {
         printLeaf("END");
 
         if (match(TT_IDENTIFIER)) {
-            auto idNode = new Node("IDENTIFIER", tokens[currentTokenIndex - 1].getLexeme(), tokens[currentTokenIndex - 1].getLine());
+            auto idNode = identifierNode(tokens[currentTokenIndex - 1]);
             node->addChild(idNode);
             printLeaf(tokens[currentTokenIndex - 1].getLexeme());
         }
         else {
-            error("Expected identifier after END");
+            error(DIAG_EXPECTED_END_ID);
         }
     }
     else {
-        error("Expected 'END'");
+        error(DIAG_EXPECTED_END);
     }
 
     decreaseIndent();
@@ -1,5 +1,7 @@
 #pragma once
 #include "Token.h"
+#include "Diagnostic.h"
+#include "Cancel.h"
 #include <vector>
 #include <fstream>
 #include <string>
@@ -9,9 +11,10 @@ struct Node {
     std::string value;
     std::vector<Node*> children;
     int lineNumber;
+    size_t offset;      //     , npos - 
 
     Node(const std::string& nodeName, const std::string& nodeValue = "", int line = -1)
-        : name(nodeName), value(nodeValue), lineNumber(line) {
+        : name(nodeName), value(nodeValue), lineNumber(line), offset(std::string::npos) {
     }
 
     void addChild(Node* child) {
@@ -23,10 +26,13 @@ class Synt {
 private:
     std::vector<Token> tokens;
     size_t currentTokenIndex;
-    std::ofstream& astOutput;
+    std::ostream& astOutput;
     int indentLevel;
     int lineNumber;
-    std::vector<std::string> errors;
+    std::vector<Diagnostic> errors;
+    ErrorBudget* budget;                //   , nullptr -  
+    bool stopped;                       //    ,  
+    CancelPoll cancelPoll;
     bool inDescriptionsSection;
 
     //  
@@ -37,9 +43,12 @@ private:
     void nextToken();
     bool match(TokenType expected);
     bool matchKeyword(const std::string& keyword);
+    Node* identifierNode(const Token& token);
 
-    void error(const std::string& message);
+    void error(DiagCode code);
+    std::string formatError(const Diagnostic& diagnostic) const;
     void syncAfterError();
+    bool pollCancel();
     void syncToNextOperator();
     void syncToNextArgument();
     void syncToEndOfExpression();
@@ -59,6 +68,7 @@ private:
     Node* parseDescr();
     Node* parseType();
     Node* parseVarList();
+    void parseArraySize(Node* varList);
     Node* parseOperators();
     Node* parseOp();
     Node* parseExpr();
@@ -66,7 +76,19 @@ private:
     Node* parseCallArguments();
 
 public:
-    Synt(const std::vector<Token>& tokenList, std::ofstream& output);
+    Synt(const std::vector<Token>& tokenList, std::ostream& output);
     void synt();
     Node* getTree() const { return root; }
+
+    //   ,  ,    
+    void setErrorBudget(ErrorBudget* errorBudget) { budget = errorBudget; }
+    bool isStopped() const { return stopped; }
+    //       ;   
+    void setCancel(const CancelToken* token) { cancelPoll.setToken(token); }
+    bool isCancelled() const { return cancelPoll.isStopped(); }
+
+    //   (Begin, Descr, Op  End)   
+    Node* parseStatement();
+    bool atEnd() const { return currentTokenIndex >= tokens.size(); }
+    const std::vector<Diagnostic>& getErrors() const { return errors; }
 };
\ No newline at end of file
@@ -22,12 +22,16 @@ private:
     std::string lexeme;
     TokenType type;
     int line;
+    int column;             //    ,  1
+    size_t offset;          //       
+    long long intValue;     //  TT_INTEGER,  
+    double realValue;       //  TT_REAL
 
 public:
-    Token() : lexeme(""), type(TT_UNKNOWN), line(1) {}
+    Token() : lexeme(""), type(TT_UNKNOWN), line(1), column(1), offset(0), intValue(0), realValue(0) {}
 
     Token(const std::string& lex, TokenType t, int ln = 1)
-        : lexeme(lex), type(t), line(ln) {
+        : lexeme(lex), type(t), line(ln), column(1), offset(0), intValue(0), realValue(0) {
     }
 
     //
@@ -35,11 +39,18 @@ public:
     std::string getKey() const { return lexeme; }
     TokenType getType() const { return type; }
     int getLine() const { return line; }
+    int getColumn() const { return column; }
+    size_t getOffset() const { return offset; }
+    long long getIntValue() const { return intValue; }
+    double getRealValue() const { return realValue; }
 
     //
     void setLexeme(const std::string& lex) { lexeme = lex; }
     void setType(TokenType t) { type = t; }
     void setLine(int ln) { line = ln; }
+    void setPosition(size_t off, int col) { offset = off; column = col; }
+    void setIntValue(long long value) { intValue = value; }
+    void setRealValue(double value) { realValue = value; }
 
     //     
     std::string typeToString() const {
@@ -0,0 +1,100 @@
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TraceEvent {
+    const char* name;
+    int64_t start;
+    int64_t duration;
+    int line;
+};
+
+//  :   ,    
+struct ThreadBuffer {
+    static const size_t CAPACITY = 1 << 16;
+
+    int id;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<size_t> count;
+    size_t dropped;
+
+    explicit ThreadBuffer(int threadId) : id(threadId), events(new TraceEvent[CAPACITY]), count(0), dropped(0) {}
+};
+
+static std::atomic<int> traceLevel(TRACE_OFF);
+static std::mutex buffersMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> buffers;     //    
+static thread_local ThreadBuffer* threadBuffer = nullptr;
+
+static const std::chrono::steady_clock::time_point traceStart = std::chrono::steady_clock::now();
+
+static ThreadBuffer* currentBuffer() {
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.emplace_back(new ThreadBuffer((int)buffers.size() + 1));
+        threadBuffer = buffers.back().get();
+    }
+    return threadBuffer;
+}
+
+//  -   "::",      
+static std::string jsonString(const char* text) {
+    std::string result = "\"";
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') result.push_back('\\');
+        result.push_back(*c);
+    }
+    return result + "\"";
+}
+
+void Trace::setLevel(TraceLevel level) {
+    traceLevel = level;
+}
+
+bool Trace::enabled(TraceLevel level) {
+    return level <= traceLevel.load(std::memory_order_relaxed) && level != TRACE_OFF;
+}
+
+int64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - traceStart).count();
+}
+
+void Trace::record(const char* name, int64_t start, int64_t end, int line) {
+    ThreadBuffer* buffer = currentBuffer();
+    size_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= ThreadBuffer::CAPACITY) {
+        buffer->dropped++;
+        return;
+    }
+    buffer->events[index] = TraceEvent{ name, start, end - start, line };
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::write(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"YandMP\"}}";
+
+    for (const auto& buffer : buffers) {
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+            << ",\"args\":{\"name\":\"thread " << buffer->id << "\",\"dropped\":" << buffer->dropped << "}}";
+
+        for (size_t i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->events[i];
+            out << ",\n{\"name\":" << jsonString(event.name) << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+            if (event.line >= 0) out << ",\"args\":{\"line\":" << event.line << "}";
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// :  ,      
+enum TraceLevel {
+    TRACE_OFF,
+    TRACE_PHASES,       //    
+    TRACE_PASSES,       //  
+    TRACE_STATEMENTS    //  
+};
+
+//   Chrome trace-event (chrome://tracing, Perfetto).
+//    :   -  ,  
+//       .   
+//     
+class Trace {
+public:
+    static void setLevel(TraceLevel level);
+    static bool enabled(TraceLevel level);
+
+    static int64_t now();       //   
+    static void record(const char* name, int64_t start, int64_t end, int line);
+
+    static bool write(const std::string& path);
+};
+
+//     ; name -  
+class TraceSpan {
+public:
+    TraceSpan(const char* spanName, TraceLevel level = TRACE_PHASES, int spanLine = -1)
+        : name(Trace::enabled(level) ? spanName : nullptr), line(spanLine), start(name ? Trace::now() : 0) {
+    }
+    ~TraceSpan() {
+        if (name) Trace::record(name, start, Trace::now(), line);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    int line;               //  , -1 - 
+    int64_t start;
+};
\ No newline at end of file
@@ -0,0 +1,617 @@
+#include "VirtualMachine.h"
+#include "Lexer.h"
+#include "Synt.h"
+#include "Semantic.h"
+#include "Jit.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+const uint32_t NO_SLOT = 0xFFFFFFFF;
+const size_t PRINT_BUFFER_LIMIT = 1 << 16;
+const size_t MAX_CODE = 1 << 26;           //    
+
+void VirtualMachine::emit(VmOp op, uint32_t arg, VmValue imm) {
+    code.push_back(VmInstr{ nullptr, op, arg, imm });
+}
+
+bool VirtualMachine::fail(const std::string& message, int line) {
+    error = "VM ERROR at line " + std::to_string(line) + ": " + message;
+    return false;
+}
+
+//  :       ,
+//    REAL.      :
+//    ,   
+bool VirtualMachine::lowerExpression(const ObjectCode& object, size_t from, size_t to, int line,
+    std::vector<TokenType>& types, std::vector<uint32_t>& lengths) {
+    const auto& instrs = object.getCode();
+
+    for (size_t i = from; i < to; i++) {
+        const Instr& instr = instrs[i];
+
+        if (instr.op == OP_CONST) {
+            const Constant& c = object.getConstants()[instr.arg];
+            VmValue imm;
+            if (c.type == TT_REAL) {
+                imm.r = c.realValue;
+                emit(VM_PUSH_R, 0, imm);
+            }
+            else {
+                imm.i = c.intValue;
+                emit(VM_PUSH_I, 0, imm);
+            }
+            types.push_back(c.type);
+            lengths.push_back(0);
+        }
+        else if (instr.op == OP_SYMBOL) {
+            uint32_t slot = slotFor(instr.arg);
+            if (slot == NO_SLOT) {
+                return fail("Undeclared variable '" + object.getSymbols()[instr.arg].name + "'", line);
+            }
+            emit(VM_LOAD, slot);
+            types.push_back(slotTypes[slot]);
+            lengths.push_back(slotLengths[slot]);
+        }
+        else if (instr.op == OP_I2R) {
+            if (types.empty()) return fail("Missing operand", line);
+            VmValue length;
+            length.i = lengths.back();
+            if (types.back() != TT_REAL) {
+                if (lengths.back() > 0) emit(VM_VI2R, (uint32_t)types.size() - 1, length);
+                else emit(VM_I2R);
+            }
+            types.back() = TT_REAL;
+        }
+        else if (instr.op >= OP_ADD && instr.op <= OP_VSUB_R) {
+            //     ,   
+            //    ;   
+            bool add = instr.op == OP_ADD || instr.op == OP_ADD_I || instr.op == OP_ADD_R ||
+                instr.op == OP_VADD_I || instr.op == OP_VADD_R;
+            if (types.size() < 2) return fail("Missing operand", line);
+            TokenType right = types.back();
+            uint32_t rightLength = lengths.back();
+            types.pop_back();
+            lengths.pop_back();
+            TokenType left = types.back();
+            uint32_t leftLength = lengths.back();
+
+            bool real = left == TT_REAL || right == TT_REAL;
+            uint32_t length = std::max(leftLength, rightLength);
+            if (leftLength > 0 && rightLength > 0 && leftLength != rightLength) {
+                return fail("Arrays of different sizes in expression", line);
+            }
+
+            if (length == 0) {
+                if (real && left != TT_REAL) emit(VM_I2R_NEXT);
+                if (real && right != TT_REAL) emit(VM_I2R);
+
+                if (add) emit(real ? VM_ADD_R : VM_ADD_I);
+                else emit(real ? VM_SUB_R : VM_SUB_I);
+            }
+            else {
+                //   ;  -     
+                uint32_t top = (uint32_t)types.size();
+                VmValue imm;
+                imm.i = length;
+                if (real && left != TT_REAL) {
+                    if (leftLength > 0) emit(VM_VI2R_NEXT, top - 1, imm);
+                    else emit(VM_I2R_NEXT);
+                }
+                if (real && right != TT_REAL) {
+                    if (rightLength > 0) emit(VM_VI2R, top, imm);
+                    else emit(VM_I2R);
+                }
+                if (leftLength == 0) emit(VM_SPLAT_NEXT, top - 1, imm);
+                if (rightLength == 0) emit(VM_SPLAT, top, imm);
+
+                if (add) emit(real ? VM_VADD_R : VM_VADD_I, top - 1, imm);
+                else emit(real ? VM_VSUB_R : VM_VSUB_I, top - 1, imm);
+            }
+            types.back() = real ? TT_REAL : TT_INTEGER;
+            lengths.back() = length;
+        }
+        else {
+            return fail("Unexpected instruction in expression", line);
+        }
+        maxStack = std::max(maxStack, types.size());
+    }
+    return true;
+}
+
+//  symbol  :     slotOf,
+//  -  -   (, )
+uint32_t& VirtualMachine::slotFor(uint32_t symbol) {
+    if (currentUnit == 0) return slotOf[symbol];
+    return calleeSlots.emplace(((uint64_t)currentUnit << 32) | symbol, NO_SLOT).first->second;
+}
+
+//   unit
+bool VirtualMachine::lowerUnit(const ObjectCode& object, size_t unit) {
+    const auto& instrs = object.getCode();
+    const auto& lines = object.getLines();
+    std::vector<TokenType> types;
+    std::vector<uint32_t> lengths;
+
+    size_t caller = currentUnit;
+    currentUnit = unit;
+    active[unit] = true;
+
+    for (size_t n = units[unit].firstLine; n < units[unit].endLine; n++) {
+        size_t from = lines[n].firstInstr;
+        size_t to = n + 1 < lines.size() ? lines[n + 1].firstInstr : instrs.size();
+        int line = lines[n].sourceLine;
+        if (from >= to || to > instrs.size()) continue;
+        if (code.size() > MAX_CODE) return fail("Program is too large after inlining of called units", line);
+
+        OpCode last = instrs[to - 1].op;
+        types.clear();
+        lengths.clear();
+
+        if (last == OP_PROGRAM || last == OP_END) {
+            //      
+        }
+        else if (last == OP_DECL || last == OP_DIM) {
+            //  ... N DECL |    DIM:    
+            TokenType type = (TokenType)instrs[from].arg;
+            uint32_t length = last == OP_DIM ? instrs[to - 2].arg : 0;
+            if (last == OP_DIM && (to - from != 4 || length == 0)) return fail("Invalid array declaration", line);
+
+            for (size_t i = from + 1; i + 2 < to; i++) {
+                uint32_t symbol = instrs[i].arg;
+                uint32_t& slot = slotFor(symbol);
+                if (slot == NO_SLOT) {
+                    //      
+                    slot = (uint32_t)slotTypes.size();
+                    slotTypes.push_back(type);
+                    slotNames.push_back((unit == 0 ? "" : units[unit].name + "_") + object.getSymbols()[symbol].name);
+                    slotLengths.push_back(length);
+                }
+                //     ,  
+                if (unit != 0) clearSlot(slot);
+            }
+            maxLength = std::max(maxLength, (size_t)length);
+        }
+        else if (last == OP_ASSIGN) {
+            //  =
+            uint32_t slot = slotFor(instrs[from].arg);
+            if (slot == NO_SLOT) {
+                return fail("Undeclared variable '" + object.getSymbols()[instrs[from].arg].name + "'", line);
+            }
+            if (!lowerExpression(object, from + 1, to - 1, line, types, lengths)) return false;
+            if (types.size() != 1) return fail("Invalid expression", line);
+
+            uint32_t length = slotLengths[slot];
+            VmValue imm;
+            imm.i = length;
+            if (length == 0 && lengths[0] > 0) return fail("Cannot assign array to scalar variable", line);
+            if (length > 0 && lengths[0] > 0 && lengths[0] != length) return fail("Array size mismatch in assignment", line);
+
+            if (slotTypes[slot] == TT_REAL && types[0] != TT_REAL) {
+                if (lengths[0] > 0) emit(VM_VI2R, 0, imm);
+                else emit(VM_I2R);
+            }
+            if (slotTypes[slot] != TT_REAL && types[0] == TT_REAL) {
+                if (lengths[0] > 0) emit(VM_VR2I, 0, imm);
+                else emit(VM_R2I);
+            }
+            if (length > 0) {
+                //    
+                if (lengths[0] == 0) emit(VM_SPLAT, 0, imm);
+                emit(VM_VSTORE, slot, imm);
+            }
+            else {
+                emit(VM_STORE, slot);
+            }
+        }
+        else if (last == OP_CALL) {
+            // ... N CALL:  Print     
+            const Symbol& proc = object.getSymbols()[instrs[from].arg];
+            if (proc.name != "Print") {
+                auto callee = unitIndex.find(proc.name);
+                if (callee == unitIndex.end()) return fail("Unknown procedure '" + proc.name + "'", line);
+                if (instrs[to - 2].arg != 1) return fail("Invalid argument list", line);
+                if (active[callee->second]) return fail("Recursive call of program '" + proc.name + "'", line);
+                if (!lowerUnit(object, callee->second)) return false;
+                continue;
+            }
+
+            if (!lowerExpression(object, from + 1, to - 2, line, types, lengths)) return false;
+            //     
+            if (types.size() + 1 != instrs[to - 2].arg) return fail("Invalid argument list", line);
+
+            VmValue imm;
+            imm.i = (long long)printTypes.size();
+            printTypes.insert(printTypes.end(), types.begin(), types.end());
+            printLengths.insert(printLengths.end(), lengths.begin(), lengths.end());
+            emit(VM_PRINT, (uint32_t)types.size(), imm);
+        }
+        else {
+            return fail("Unknown statement", line);
+        }
+    }
+
+    active[unit] = false;
+    currentUnit = caller;
+    return true;
+}
+
+//    
+void VirtualMachine::clearSlot(uint32_t slot) {
+    VmValue length;
+    length.i = slotLengths[slot];
+    emit(VM_PUSH_I);
+    if (slotLengths[slot] > 0) {
+        emit(VM_SPLAT, 0, length);
+        emit(VM_VSTORE, slot, length);
+    }
+    else {
+        emit(VM_STORE, slot);
+    }
+    maxStack = std::max(maxStack, (size_t)1);
+}
+
+bool VirtualMachine::load(const ObjectCode& object) {
+    code.clear();
+    slotTypes.clear();
+    slotNames.clear();
+    slotLengths.clear();
+    printTypes.clear();
+    printLengths.clear();
+    error.clear();
+    maxStack = 0;
+    maxLength = 0;
+    threaded = false;
+    units.clear();
+    unitIndex.clear();
+
+    // -   PROGRAM  END.  ,  
+    //   CALL;       
+    const auto& instrs = object.getCode();
+    const auto& lines = object.getLines();
+    for (size_t n = 0; n < lines.size(); n++) {
+        size_t to = n + 1 < lines.size() ? lines[n + 1].firstInstr : instrs.size();
+        if (lines[n].firstInstr >= to || to > instrs.size()) continue;
+        OpCode last = instrs[to - 1].op;
+
+        if (last == OP_PROGRAM) {
+            const std::string& name = object.getSymbols()[instrs[lines[n].firstInstr].arg].name;
+            units.push_back(Unit{ name, units.empty() ? 0 : n, lines.size() });
+            unitIndex.emplace(name, units.size() - 1);
+        }
+        else if (last == OP_END && !units.empty()) {
+            units.back().endLine = n + 1;
+        }
+    }
+    if (units.empty()) units.push_back(Unit{ "", 0, lines.size() });
+
+    slotOf.assign(object.getSymbols().size(), NO_SLOT);
+    calleeSlots.clear();
+    active.assign(units.size(), false);
+    currentUnit = 0;
+    if (!lowerUnit(object, 0)) return false;
+
+    emit(VM_HALT);
+    slots.assign(slotTypes.size(), VmValue{ 0 });
+    stack.assign(maxStack + 1, VmValue{ 0 });
+
+    //   ;      
+    slotOffsets.assign(slotTypes.size(), 0);
+    size_t elements = 0;
+    for (size_t slot = 0; slot < slotLengths.size(); slot++) {
+        slotOffsets[slot] = elements;
+        elements += slotLengths[slot];
+    }
+    arrays.assign(elements, VmValue{ 0 });
+    temps.assign(maxLength > 0 ? (maxStack + 1) * maxLength : 0, VmValue{ 0 });
+    return true;
+}
+
+void VirtualMachine::print(const VmValue* args, uint32_t types, uint32_t count) {
+    char number[32];
+    bool first = true;
+    for (uint32_t k = 0; k < count; k++) {
+        //    
+        uint32_t length = printLengths[types + k];
+        const VmValue* values = length > 0 ? args[k].p : &args[k];
+        for (uint32_t e = 0; e < (length > 0 ? length : 1); e++) {
+            if (printTypes[types + k] == TT_REAL) {
+                std::snprintf(number, sizeof(number), "%g", values[e].r);
+            }
+            else {
+                std::snprintf(number, sizeof(number), "%lld", values[e].i);
+            }
+            if (!first) printBuffer += ' ';
+            printBuffer += number;
+            first = false;
+        }
+    }
+    printBuffer += '\n';
+}
+
+void VirtualMachine::callPrint(const VmValue* args, uint32_t types, uint32_t count, std::ostream& out) {
+    print(args, types, count);
+    if (printBuffer.size() >= PRINT_BUFFER_LIMIT) flush(out);
+}
+
+void VirtualMachine::flush(std::ostream& out) {
+    out.write(printBuffer.data(), printBuffer.size());
+    printBuffer.clear();
+}
+
+//     2^64,    
+static inline long long wrapAdd(long long a, long long b) {
+    return (long long)((unsigned long long)a + (unsigned long long)b);
+}
+
+static inline long long wrapSub(long long a, long long b) {
+    return (long long)((unsigned long long)a - (unsigned long long)b);
+}
+
+//         SIMD
+void vectorAddI(VmValue* dst, const VmValue* a, const VmValue* b, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].i = wrapAdd(a[k].i, b[k].i);
+}
+
+void vectorSubI(VmValue* dst, const VmValue* a, const VmValue* b, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].i = wrapSub(a[k].i, b[k].i);
+}
+
+void vectorAddR(VmValue* dst, const VmValue* a, const VmValue* b, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].r = a[k].r + b[k].r;
+}
+
+void vectorSubR(VmValue* dst, const VmValue* a, const VmValue* b, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].r = a[k].r - b[k].r;
+}
+
+void vectorI2R(VmValue* dst, const VmValue* a, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].r = (double)a[k].i;
+}
+
+void vectorR2I(VmValue* dst, const VmValue* a, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k].i = (long long)a[k].r;
+}
+
+void vectorFill(VmValue* dst, VmValue value, size_t n) {
+    for (size_t k = 0; k < n; k++) dst[k] = value;
+}
+
+uint64_t VirtualMachine::run(std::ostream& out) {
+    if (code.empty()) return 0;
+    std::fill(slots.begin(), slots.end(), VmValue{ 0 });
+    std::fill(arrays.begin(), arrays.end(), VmValue{ 0 });
+    for (size_t slot = 0; slot < slotLengths.size(); slot++) {
+        if (slotLengths[slot] > 0) slots[slot].p = arrays.data() + slotOffsets[slot];
+    }
+
+    VmValue* vars = slots.data();
+    VmValue* temp = temps.data();       //   k - temp + k * maxLength
+    size_t stride = maxLength;
+    VmValue* sp = stack.data();         //sp   , stack[0]  
+    VmInstr* ip = code.data();
+
+#ifdef VM_THREADED
+    static const void* const labels[VM_OP_COUNT] = {
+        &&L_VM_PUSH_I, &&L_VM_PUSH_R, &&L_VM_LOAD, &&L_VM_STORE,
+        &&L_VM_ADD_I, &&L_VM_ADD_R, &&L_VM_SUB_I, &&L_VM_SUB_R,
+        &&L_VM_I2R, &&L_VM_I2R_NEXT, &&L_VM_R2I,
+        &&L_VM_SPLAT, &&L_VM_SPLAT_NEXT, &&L_VM_VADD_I, &&L_VM_VADD_R, &&L_VM_VSUB_I, &&L_VM_VSUB_R,
+        &&L_VM_VI2R, &&L_VM_VI2R_NEXT, &&L_VM_VR2I, &&L_VM_VSTORE,
+        &&L_VM_PRINT, &&L_VM_HALT
+    };
+    if (!threaded) {
+        for (auto& instr : code) instr.handler = labels[instr.op];
+        threaded = true;
+    }
+#define VM_CASE(op) L_##op:
+#define VM_NEXT() goto *(++ip)->handler
+    goto *ip->handler;
+#else
+#define VM_CASE(op) case op:
+#define VM_NEXT() ++ip; break
+    for (;;) switch (ip->op) {
+#endif
+
+    VM_CASE(VM_PUSH_I)
+        (++sp)->i = ip->imm.i;
+        VM_NEXT();
+    VM_CASE(VM_PUSH_R)
+        (++sp)->r = ip->imm.r;
+        VM_NEXT();
+    VM_CASE(VM_LOAD)
+        *++sp = vars[ip->arg];
+        VM_NEXT();
+    VM_CASE(VM_STORE)
+        vars[ip->arg] = *sp--;
+        VM_NEXT();
+    VM_CASE(VM_ADD_I)
+        sp[-1].i = wrapAdd(sp[-1].i, sp[0].i);
+        --sp;
+        VM_NEXT();
+    VM_CASE(VM_ADD_R)
+        sp[-1].r += sp[0].r;
+        --sp;
+        VM_NEXT();
+    VM_CASE(VM_SUB_I)
+        sp[-1].i = wrapSub(sp[-1].i, sp[0].i);
+        --sp;
+        VM_NEXT();
+    VM_CASE(VM_SUB_R)
+        sp[-1].r -= sp[0].r;
+        --sp;
+        VM_NEXT();
+    VM_CASE(VM_I2R)
+        sp->r = (double)sp->i;
+        VM_NEXT();
+    VM_CASE(VM_I2R_NEXT)
+        sp[-1].r = (double)sp[-1].i;
+        VM_NEXT();
+    VM_CASE(VM_R2I)
+        sp->i = (long long)sp->r;
+        VM_NEXT();
+    VM_CASE(VM_SPLAT) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorFill(dst, sp[0], (size_t)ip->imm.i);
+        sp[0].p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_SPLAT_NEXT) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorFill(dst, sp[-1], (size_t)ip->imm.i);
+        sp[-1].p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VADD_I) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorAddI(dst, sp[-1].p, sp[0].p, (size_t)ip->imm.i);
+        (--sp)->p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VADD_R) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorAddR(dst, sp[-1].p, sp[0].p, (size_t)ip->imm.i);
+        (--sp)->p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VSUB_I) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorSubI(dst, sp[-1].p, sp[0].p, (size_t)ip->imm.i);
+        (--sp)->p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VSUB_R) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorSubR(dst, sp[-1].p, sp[0].p, (size_t)ip->imm.i);
+        (--sp)->p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VI2R) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorI2R(dst, sp[0].p, (size_t)ip->imm.i);
+        sp[0].p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VI2R_NEXT) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorI2R(dst, sp[-1].p, (size_t)ip->imm.i);
+        sp[-1].p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VR2I) {
+        VmValue* dst = temp + ip->arg * stride;
+        vectorR2I(dst, sp[0].p, (size_t)ip->imm.i);
+        sp[0].p = dst;
+        VM_NEXT();
+    }
+    VM_CASE(VM_VSTORE)
+        if (vars[ip->arg].p != sp->p) {
+            std::memcpy(vars[ip->arg].p, sp->p, (size_t)ip->imm.i * sizeof(VmValue));
+        }
+        --sp;
+        VM_NEXT();
+    VM_CASE(VM_PRINT)
+        sp -= ip->arg;
+        callPrint(sp + 1, (uint32_t)ip->imm.i, ip->arg, out);
+        VM_NEXT();
+    VM_CASE(VM_HALT)
+        flush(out);
+        return (uint64_t)(ip - code.data()) + 1;
+
+#ifndef VM_THREADED
+    default:
+        flush(out);
+        return (uint64_t)(ip - code.data());
+    }
+#endif
+#undef VM_CASE
+#undef VM_NEXT
+}
+
+//  statements     
+//(   ,    ),
+// 1000  -  Print
+static std::string generateProgram(int statements) {
+    const int vars = 8;
+    std::ostringstream src;
+
+    src << "PROGRAM Bench\nINTEGER ";
+    for (int v = 0; v < vars; v++) src << (v ? ", " : "") << "i" << (char)('a' + v);
+    src << "\nREAL ";
+    for (int v = 0; v < vars; v++) src << (v ? ", " : "") << "r" << (char)('a' + v);
+    src << "\n";
+
+    for (int n = 0; n < statements; n++) {
+        char a = 'a' + n % vars, b = 'a' + (n * 3 + 1) % vars, c = 'a' + (n * 5 + 2) % vars;
+        if (n % 1000 == 999) {
+            src << "CALL Print (i" << a << ", r" << b << ")\n";
+        }
+        else if (n % 2 == 0) {
+            src << "i" << a << " = i" << b << " + i" << c << " - " << (n % 7 + 1) << "\n";
+        }
+        else {
+            src << "r" << a << " = r" << b << " - r" << c << " + 0." << (n % 9 + 1) << "\n";
+        }
+    }
+    src << "END Bench\n";
+    return src.str();
+}
+
+void benchmarkVm(int statements, int repeats, std::ostream& report) {
+    typedef std::chrono::steady_clock Clock;
+    std::ostream nullOutput(nullptr);
+
+    //    
+    auto compileStart = Clock::now();
+    std::vector<Token> tokens = Lexer::tokenize(generateProgram(statements));
+    Synt parser(tokens, nullOutput);
+    parser.synt();
+    SemanticAnalyzer analyzer(parser.getTree(), nullOutput);
+    analyzer.analyze();
+
+    ObjectCode object;
+    object.build(analyzer.getPostfixCode(), analyzer.getPostfixLines());
+
+    VirtualMachine vm;
+    if (!vm.load(object)) {
+        report << vm.getError() << "\n";
+        return;
+    }
+    double compileSeconds = std::chrono::duration<double>(Clock::now() - compileStart).count();
+
+    uint64_t executed = 0;
+    auto runStart = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        executed += vm.run(nullOutput);
+    }
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+    report << "Statements: " << statements << "\n";
+    report << "VM instructions: " << vm.getCodeSize() << "\n";
+    report << "Compile time: " << compileSeconds * 1000 << " ms\n";
+    report << "Runs: " << repeats << ", executed " << executed << " instructions in "
+        << runSeconds * 1000 << " ms\n";
+    if (runSeconds > 0) {
+        report << "Speed: " << executed / runSeconds / 1e6 << " M instructions/s\n";
+    }
+
+    //     ;     
+    JitCompiler jit;
+    if (!jit.compile(vm)) {
+        report << "JIT: " << jit.getError() << "\n";
+        return;
+    }
+    auto jitStart = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        jit.run(nullOutput);
+    }
+    double jitSeconds = std::chrono::duration<double>(Clock::now() - jitStart).count();
+
+    report << "JIT code: " << jit.getCodeSize() << " bytes, " << repeats << " runs in "
+        << jitSeconds * 1000 << " ms\n";
+    if (jitSeconds > 0) {
+        report << "JIT speed: " << executed / jitSeconds / 1e6 << " M instructions/s\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+#include "ObjectCode.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//  (goto   )  GCC  Clang,  - switch
+#if defined(__GNUC__)
+#define VM_THREADED
+#endif
+
+//      ;    
+union VmValue {
+    long long i;
+    double r;
+    VmValue* p;     //    
+};
+
+//  :     
+enum VmOp : uint8_t {
+    VM_PUSH_I,      // INTEGER (imm)
+    VM_PUSH_R,      // REAL (imm)
+    VM_LOAD,        //  (arg -  )
+    VM_STORE,       //  (arg -  )
+    VM_ADD_I,
+    VM_ADD_R,
+    VM_SUB_I,
+    VM_SUB_R,
+    VM_I2R,         //INTEGER -> REAL   
+    VM_I2R_NEXT,    //INTEGER -> REAL    
+    VM_R2I,         //REAL -> INTEGER   
+    // :     ,  
+    //   (arg -  ), imm.i - 
+    VM_SPLAT,       //   ->    
+    VM_SPLAT_NEXT,  //     
+    VM_VADD_I,
+    VM_VADD_R,
+    VM_VSUB_I,
+    VM_VSUB_R,
+    VM_VI2R,
+    VM_VI2R_NEXT,
+    VM_VR2I,
+    VM_VSTORE,      //    (arg -  )
+    VM_PRINT,       //Print (arg -  , imm.i -     printTypes    printLengths)
+    VM_HALT,
+    VM_OP_COUNT
+};
+
+struct VmInstr {
+    const void* handler;    //    
+    VmOp op;
+    uint32_t arg;
+    VmValue imm;
+};
+
+//  :       
+//         
+class VirtualMachine {
+public:
+    VirtualMachine() : maxStack(0), maxLength(0), threaded(false), currentUnit(0) {}
+
+    //     ; false -     .
+    //   PROGRAM ... END  , CALL  
+    //  ;      
+    bool load(const ObjectCode& object);
+    const std::string& getError() const { return error; }
+
+    // ,  Print ;    
+    uint64_t run(std::ostream& out);
+
+    //  Print:  args,     printTypes[types]
+    void callPrint(const VmValue* args, uint32_t types, uint32_t count, std::ostream& out);
+    void flush(std::ostream& out);
+
+    size_t getCodeSize() const { return code.size(); }
+    const std::vector<VmInstr>& getCode() const { return code; }
+    const std::vector<TokenType>& getSlotTypes() const { return slotTypes; }
+    const std::vector<std::string>& getSlotNames() const { return slotNames; }
+    const std::vector<TokenType>& getPrintTypes() const { return printTypes; }
+    const std::vector<uint32_t>& getSlotLengths() const { return slotLengths; }
+    const std::vector<uint32_t>& getPrintLengths() const { return printLengths; }
+    size_t getMaxStack() const { return maxStack; }
+    const std::vector<VmValue>& getSlots() const { return slots; }
+
+private:
+    std::vector<VmInstr> code;
+    std::vector<VmValue> slots;
+    std::vector<TokenType> slotTypes;
+    std::vector<std::string> slotNames;
+    std::vector<VmValue> stack;
+    std::vector<TokenType> printTypes;
+    std::vector<uint32_t> slotOf;       //  ->    
+    std::vector<uint32_t> slotLengths;  //   , 0 -  
+    std::vector<size_t> slotOffsets;    //    arrays
+    std::vector<uint32_t> printLengths;
+    std::vector<VmValue> arrays;        //  
+    std::vector<VmValue> temps;         // ,  maxLength    
+    size_t maxStack;
+    size_t maxLength;                   //  
+    bool threaded;
+    std::string error;
+    std::string printBuffer;
+
+    //  :  firstLine..endLine-1
+    struct Unit {
+        std::string name;
+        size_t firstLine;
+        size_t endLine;
+    };
+    std::vector<Unit> units;
+    std::unordered_map<std::string, size_t> unitIndex;
+    std::unordered_map<uint64_t, uint32_t> calleeSlots;    //( << 32 | ) -> 
+    std::vector<bool> active;           //  
+    size_t currentUnit;
+
+    void emit(VmOp op, uint32_t arg = 0, VmValue imm = VmValue{ 0 });
+    bool fail(const std::string& message, int line);
+    uint32_t& slotFor(uint32_t symbol);
+    bool lowerUnit(const ObjectCode& object, size_t unit);
+    void clearSlot(uint32_t slot);
+    bool lowerExpression(const ObjectCode& object, size_t from, size_t to, int line,
+        std::vector<TokenType>& types, std::vector<uint32_t>& lengths);
+    void print(const VmValue* args, uint32_t types, uint32_t count);
+};
+
+//        .
+//     
+void vectorAddI(VmValue* dst, const VmValue* a, const VmValue* b, size_t n);
+void vectorSubI(VmValue* dst, const VmValue* a, const VmValue* b, size_t n);
+void vectorAddR(VmValue* dst, const VmValue* a, const VmValue* b, size_t n);
+void vectorSubR(VmValue* dst, const VmValue* a, const VmValue* b, size_t n);
+void vectorI2R(VmValue* dst, const VmValue* a, size_t n);
+void vectorR2I(VmValue* dst, const VmValue* a, size_t n);
+void vectorFill(VmValue* dst, VmValue value, size_t n);
+
+//       statements 
+void benchmarkVm(int statements, int repeats, std::ostream& report);
\ No newline at end of file
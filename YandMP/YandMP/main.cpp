@@ -1,47 +1,292 @@
-#include "Lexer.h"
-#include "Synt.h"
-#include "Semantic.h"
-#include <iostream>
+#include "Compiler.h"
+#include "Incremental.h"
+#include "ObjectCode.h"
+#include "VirtualMachine.h"
+#include "Jit.h"
+#include "CTranslator.h"
+#include "Benchmark.h"
+#include "Stats.h"
+#include "Memory.h"
+#include "Trace.h"
+#include "QueryServer.h"
+#include "Batch.h"
+#include "Cancel.h"
+#include "SelfTest.h"
+#include <cstdlib>
 #include <fstream>
-#include <vector>
-
-int main() {
-    std::string inFile = "input.txt";
-    std::string lexerOutFile = "output.txt";
-    std::string parserOutFile = "output2.txt";
-    std::string semanticOutFile = "output3.txt";
-
-    // 
-    Lexer lexer(inFile, lexerOutFile);
-    lexer.run();
+#include <iostream>
+#include <string>
 
-    //       
-    std::vector<Token> tokens = lexer.getTokens();
+int main(int argc, char* argv[]) {
+    CompileFiles files;
+    files.inFile = "input.txt";
+    files.lexerOutFile = "output.txt";
+    files.parserOutFile = "output2.txt";
+    files.semanticOutFile = "output3.txt";
 
-    //  
-    std::vector<Token> validTokens;
-    for (const auto& token : tokens) {
-        if (token.getType() != TT_ERROR and token.getType() != TT_UNKNOWN) {
-            validTokens.push_back(token);
+    bool watchMode = false;
+    bool statsJson = false;
+    std::string traceFile;
+    unsigned threads = 0;
+    long long deadline = 0;
+    CancelToken cancel;
+    CompileStats stats;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--watch") {
+            watchMode = true;
+        }
+        else if (arg == "--binary") {
+            files.binaryOutFile = "output.bin";
+        }
+        else if (arg == "-O" || arg == "--optimize") {
+            files.optimize = true;
+        }
+        else if (arg == "--fast-math") {
+            //    -O:      
+            files.fastMath = true;
+        }
+        else if (arg == "--stats" || arg == "--stats-json") {
+            //    :   JSON   
+            files.stats = &stats;
+            statsJson = arg == "--stats-json";
+        }
+        else if (arg == "--memory" || (arg == "--memory-budget" && i + 1 < argc)) {
+            //    ; --memory-budget N[K|M|G] -   
+            size_t budget = 0;
+            if (arg == "--memory-budget") {
+                char* suffix = nullptr;
+                budget = (size_t)std::strtoull(argv[++i], &suffix, 10);
+                if (*suffix == 'K' || *suffix == 'k') budget <<= 10;
+                else if (*suffix == 'M' || *suffix == 'm') budget <<= 20;
+                else if (*suffix == 'G' || *suffix == 'g') budget <<= 30;
+            }
+            if (!MemoryTracker::isSupported()) {
+                std::cerr << "Memory tracking is not supported on this platform\n";
+            }
+            MemoryTracker::enable(budget);
+            files.stats = &stats;
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            //    Chrome trace-event (Perfetto)
+            traceFile = argv[++i];
+            if (!Trace::enabled(TRACE_PHASES)) Trace::setLevel(TRACE_PASSES);
+        }
+        else if (arg == "--trace-level" && i + 1 < argc) {
+            //phases | passes | statements
+            std::string level = argv[++i];
+            if (level == "phases") Trace::setLevel(TRACE_PHASES);
+            else if (level == "passes") Trace::setLevel(TRACE_PASSES);
+            else if (level == "statements") Trace::setLevel(TRACE_STATEMENTS);
+            else {
+                std::cerr << "Unknown trace level: " << level << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--max-errors" && i + 1 < argc) {
+            //     N 
+            int limit = std::atoi(argv[++i]);
+            files.maxErrors = limit > 0 ? (size_t)limit : 0;
+        }
+        else if (arg == "--deadline" && i + 1 < argc) {
+            //   :    
+            deadline = std::atoll(argv[++i]);
+            files.cancel = deadline > 0 ? &cancel : nullptr;
+        }
+        else if (arg == "--object") {
+            files.objectOutFile = "output.obj";
+        }
+        else if (arg == "--disasm" && i + 1 < argc) {
+            //     
+            ObjectCode object;
+            if (!object.read(argv[++i])) {
+                std::cerr << "Cannot read object file\n";
+                return 1;
+            }
+            for (const auto& line : object.disassemble()) {
+                std::cout << line << "\n";
+            }
+            return 0;
+        }
+        else if (arg == "--run" && i + 1 < argc) {
+            //    
+            ObjectCode object;
+            VirtualMachine vm;
+            if (!object.read(argv[++i])) {
+                std::cerr << "Cannot read object file\n";
+                return 1;
+            }
+            if (!vm.load(object)) {
+                std::cerr << vm.getError() << "\n";
+                return 1;
+            }
+            vm.run(std::cout);
+            return 0;
+        }
+        else if (arg == "--jit" && i + 1 < argc) {
+            //     ,   -  
+            ObjectCode object;
+            VirtualMachine vm;
+            JitCompiler jit;
+            if (!object.read(argv[++i])) {
+                std::cerr << "Cannot read object file\n";
+                return 1;
+            }
+            if (!vm.load(object)) {
+                std::cerr << vm.getError() << "\n";
+                return 1;
+            }
+            if (jit.compile(vm)) {
+                jit.run(std::cout);
+            }
+            else {
+                std::cerr << jit.getError() << ", using VM\n";
+                vm.run(std::cout);
+            }
+            return 0;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            //      ,   -   
+            int count = std::atoi(argv[++i]);
+            threads = count > 0 ? (unsigned)count : 0;
+            files.threads = threads;
+        }
+        else if (arg == "--batch" && i + 2 < argc) {
+            //       : --batch _ 
+            ObjectCode object;
+            VirtualMachine vm;
+            BatchRunner batch;
+            if (!object.read(argv[++i])) {
+                std::cerr << "Cannot read object file\n";
+                return 1;
+            }
+            if (!vm.load(object)) {
+                std::cerr << vm.getError() << "\n";
+                return 1;
+            }
+            if (!batch.load(vm) || !batch.readValues(argv[++i])) {
+                std::cerr << batch.getError() << "\n";
+                return 1;
+            }
+            batch.run(std::cout, threads);
+            return 0;
+        }
+        else if (arg == "--emit-c" && i + 1 < argc) {
+            //      C (output.c)
+            ObjectCode object;
+            CTranslator translator;
+            if (!object.read(argv[++i])) {
+                std::cerr << "Cannot read object file\n";
+                return 1;
+            }
+            std::ofstream cOutput("output.c");
+            if (!translator.translate(object, cOutput)) {
+                std::cerr << translator.getError() << "\n";
+                return 1;
+            }
+            std::cout << "C translation written to output.c\n";
+            return 0;
+        }
+        else if (arg == "--bench") {
+            //  : --bench [|all [ []]],  JSON
+            std::string shape = i + 1 < argc ? argv[++i] : "all";
+            int statements = i + 1 < argc ? std::atoi(argv[++i]) : 10000;
+            int repeats = i + 1 < argc ? std::atoi(argv[++i]) : 10;
+            if (!runBenchmarks(shape, statements > 0 ? statements : 10000, repeats > 0 ? repeats : 10, std::cout)) {
+                std::cerr << "Unknown benchmark shape: " << shape << "\n";
+                return 1;
+            }
+            return 0;
+        }
+        else if (arg == "--bench-scaling") {
+            //     : --bench-scaling [|all [ []]]
+            std::string shape = i + 1 < argc ? argv[++i] : "all";
+            int steps = i + 1 < argc ? std::atoi(argv[++i]) : 6;
+            int repeats = i + 1 < argc ? std::atoi(argv[++i]) : 5;
+            bool withinBounds = true;
+            if (!runScaling(shape, steps >= 2 ? steps : 6, repeats > 0 ? repeats : 5, std::cout, withinBounds)) {
+                std::cerr << "Unknown scaling shape: " << shape << "\n";
+                return 1;
+            }
+            if (!withinBounds) {
+                std::cerr << "Complexity bound exceeded\n";
+                return 1;
+            }
+            return 0;
+        }
+        else if (arg == "--serve") {
+            //  : --serve []
+            int port = i + 1 < argc ? std::atoi(argv[++i]) : 7411;
+            QueryServer server(files);
+            if (!server.load()) {
+                std::cerr << "Cannot open input file\n";
+                return 1;
+            }
+            if (!server.serve(port > 0 ? port : 7411)) {
+                std::cerr << "Cannot listen on port " << port << "\n";
+                return 1;
+            }
+            return 0;
+        }
+        else if (arg == "--self-test") {
+            // ,   ,   
+            return runSelfTest(std::cout) ? 0 : 1;
+        }
+        else if (arg == "--bench-vm") {
+            //   : --bench-vm [ []]
+            int statements = i + 1 < argc ? std::atoi(argv[++i]) : 100000;
+            int repeats = i + 1 < argc ? std::atoi(argv[++i]) : 20;
+            benchmarkVm(statements > 0 ? statements : 100000, repeats > 0 ? repeats : 20, std::cout);
+            return 0;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
         }
     }
 
-    // 
-    std::ofstream parserOutput(parserOutFile);
-    Synt parser(validTokens, parserOutput);
-    parser.synt();
-
-    // 
-    Node* astRoot = parser.getTree();
+    // :       
+    if (watchMode) {
+        IncrementalCompiler compiler(files);
+        compiler.setDeadline(deadline);
+        compiler.watch();
+        return 0;
+    }
 
-    // 
-    std::ofstream semanticOutput(semanticOutFile);
-    SemanticAnalyzer semanticAnalyzer(astRoot, semanticOutput);
-    semanticAnalyzer.analyze();
+    try {
+        //    ,     
+        if (deadline > 0) cancel.setTimeout(deadline);
+        compileFile(files);
+    }
+    catch (const MemoryBudgetExceeded&) {
+        // ,   
+        std::cerr << "Compilation aborted: memory budget of " << MemoryTracker::getBudget() << " bytes exceeded\n";
+        if (files.stats) stats.printSummary(std::cerr);
+        return 2;
+    }
+    catch (const CompilationCancelled& cancelled) {
+        std::cerr << "Compilation aborted: " << cancelled.what() << " (" << deadline << " ms)\n";
+        if (files.stats) stats.printSummary(std::cerr);
+        return 3;
+    }
 
-    std::cout << "Lexical output written to " << lexerOutFile << "\n";
-    std::cout << "Parser output written to " << parserOutFile << "\n";
-    std::cout << "Semantic output written to " << semanticOutFile << "\n";
+    std::cout << "Lexical output written to " << files.lexerOutFile << "\n";
+    std::cout << "Parser output written to " << files.parserOutFile << "\n";
+    std::cout << "Semantic output written to " << files.semanticOutFile << "\n";
+    if (!files.binaryOutFile.empty()) {
+        std::cout << "Binary output written to " << files.binaryOutFile << "\n";
+    }
+    if (!files.objectOutFile.empty()) {
+        std::cout << "Object code written to " << files.objectOutFile << "\n";
+    }
+    if (!traceFile.empty()) {
+        if (Trace::write(traceFile)) std::cout << "Trace written to " << traceFile << "\n";
+        else std::cerr << "Cannot write trace file\n";
+    }
+    if (files.stats) {
+        if (statsJson) stats.printJson(std::cout);
+        else stats.printSummary(std::cout);
+    }
 
     return 0;
 }
\ No newline at end of file